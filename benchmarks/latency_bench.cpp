@@ -0,0 +1,362 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Measures how long logging calls block the calling thread when a sink is slow. Average
+// throughput hides stalls, so every call is timed individually and the distribution is reported
+// as percentiles, for 1..N producer threads and for each sink configuration.
+
+#include <rapids_logger/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @brief A log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values below 2^precision_bits nanoseconds are recorded exactly, and larger values with
+ * precision_bits significant bits (a relative error below 1%), so recording is a few integer
+ * operations and the histogram has a fixed size however long the run.
+ */
+class histogram {
+ public:
+  static constexpr int precision_bits         = 8;
+  static constexpr std::uint64_t sub_buckets = std::uint64_t{1} << precision_bits;
+  static constexpr int max_exponent          = 40;  // Values up to about 2^48 ns, i.e. days
+
+  void record(std::uint64_t ns)
+  {
+    ++counts_[index(ns)];
+    ++total_;
+    max_ = std::max(max_, ns);
+  }
+
+  void merge(histogram const& other)
+  {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  /**
+   * @brief Get the smallest value that at least the given fraction of recorded values are at.
+   */
+  std::uint64_t percentile(double fraction) const
+  {
+    auto const rank = static_cast<std::uint64_t>(fraction * static_cast<double>(total_));
+    std::uint64_t seen{0};
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      seen += counts_[i];
+      if (seen > rank) { return std::min(upper_bound(i), max_); }
+    }
+    return max_;
+  }
+
+  std::uint64_t max() const { return max_; }
+  std::uint64_t total() const { return total_; }
+
+ private:
+  static int bit_width(std::uint64_t v)
+  {
+    int width{0};
+    while (v != 0) {
+      v >>= 1;
+      ++width;
+    }
+    return width;
+  }
+
+  static std::size_t index(std::uint64_t ns)
+  {
+    if (ns < sub_buckets) { return static_cast<std::size_t>(ns); }
+    auto const shift    = std::min(bit_width(ns) - precision_bits, max_exponent);
+    auto const mantissa = std::min(ns >> shift, sub_buckets - 1);
+    return static_cast<std::size_t>(sub_buckets + (shift - 1) * (sub_buckets / 2) +
+                                    (mantissa - sub_buckets / 2));
+  }
+
+  static std::uint64_t upper_bound(std::size_t i)
+  {
+    if (i < sub_buckets) { return i; }
+    auto const offset   = i - sub_buckets;
+    auto const shift    = static_cast<int>(offset / (sub_buckets / 2)) + 1;
+    auto const mantissa = offset % (sub_buckets / 2) + sub_buckets / 2;
+    return ((mantissa + 1) << shift) - 1;
+  }
+
+  std::array<std::uint64_t, sub_buckets + max_exponent * (sub_buckets / 2)> counts_{};
+  std::uint64_t total_{0};
+  std::uint64_t max_{0};
+};
+
+/**
+ * @brief Block the calling thread for a duration, as a sink waiting on slow I/O would.
+ *
+ * Spinning rather than sleeping keeps short delays accurate.
+ */
+void block_for(std::chrono::nanoseconds duration)
+{
+  if (duration.count() <= 0) { return; }
+  auto const deadline = clock_type::now() + duration;
+  while (clock_type::now() < deadline) {}
+}
+
+struct options {
+  int max_threads{4};
+  int messages{100000};  ///< Per thread
+  std::chrono::nanoseconds delay{std::chrono::microseconds{1}};
+  std::uint64_t bytes_per_second{200'000'000};
+  int stall_every{10000};
+  std::chrono::nanoseconds stall{std::chrono::milliseconds{1}};
+  bool tsc{false};
+  int writers{1};  ///< Writer threads of the async configurations
+};
+
+/**
+ * @brief The delays injected by the slow sinks.
+ *
+ * Besides the steady per-record cost, every stall_every-th write stalls, like a log agent or a
+ * disk that periodically stops accepting data.
+ */
+class delay_model {
+ public:
+  explicit delay_model(options const& opts) : opts_{opts} {}
+
+  void stall_periodically()
+  {
+    if (opts_.stall_every <= 0) { return; }
+    if (writes_.fetch_add(1, std::memory_order_relaxed) % opts_.stall_every ==
+        static_cast<std::uint64_t>(opts_.stall_every - 1)) {
+      block_for(opts_.stall);
+    }
+  }
+
+  options const& opts() const { return opts_; }
+
+ private:
+  options const& opts_;
+  std::atomic<std::uint64_t> writes_{0};
+};
+
+delay_model* callback_delays{nullptr};
+
+/**
+ * @brief A callback that takes a fixed time per record, plus periodic stalls.
+ */
+void slow_callback(int, char const*)
+{
+  block_for(callback_delays->opts().delay);
+  callback_delays->stall_periodically();
+}
+
+/**
+ * @brief A stream buffer that accepts output at a limited bandwidth, like a throttled pipe.
+ */
+class throttled_buf : public std::streambuf {
+ public:
+  explicit throttled_buf(delay_model& delays) : delays_{delays} {}
+
+ protected:
+  int_type overflow(int_type ch) override
+  {
+    consume(1);
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(char const*, std::streamsize count) override
+  {
+    consume(static_cast<std::uint64_t>(count));
+    return count;
+  }
+
+ private:
+  void consume(std::uint64_t bytes)
+  {
+    auto const rate = delays_.opts().bytes_per_second;
+    if (rate > 0) { block_for(std::chrono::nanoseconds{bytes * 1'000'000'000 / rate}); }
+    delays_.stall_periodically();
+  }
+
+  delay_model& delays_;
+};
+
+struct sink_config {
+  std::string name;
+  std::function<rapids_logger::sink_ptr()> make;
+  bool async{false};  ///< Whether the logger writes to the sink from writer threads
+};
+
+/**
+ * @brief Log from the given number of threads at once and collect the per-call latencies.
+ */
+histogram run(rapids_logger::logger& logger, int n_threads, int messages, double& seconds)
+{
+  std::vector<histogram> histograms(static_cast<std::size_t>(n_threads));
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t] {
+      auto& h = histograms[static_cast<std::size_t>(t)];
+      ready.fetch_add(1);
+      while (!go.load()) {}
+      for (int i = 0; i < messages; ++i) {
+        auto const start = clock_type::now();
+        logger.info("thread %d message %d with a payload similar to real records", t, i);
+        auto const elapsed = clock_type::now() - start;
+        h.record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+      }
+    });
+  }
+  while (ready.load() < n_threads) {}
+  auto const start = clock_type::now();
+  go.store(true);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+  histogram total;
+  for (auto const& h : histograms) {
+    total.merge(h);
+  }
+  return total;
+}
+
+void usage()
+{
+  std::cerr << "Usage: LATENCY_BENCH [OPTIONS]\n"
+               "\n"
+               "  --threads N         Run with 1, 2, 4, ... up to N producer threads (default: 4)\n"
+               "  --messages N        Records logged by each thread (default: 100000)\n"
+               "  --delay-ns N        Time the slow callback sink takes per record\n"
+               "                      (default: 1000)\n"
+               "  --bandwidth N       Bytes per second accepted by the throttled stream, 0 for\n"
+               "                      unlimited (default: 200000000)\n"
+               "  --stall-every N     Stall every Nth write to a slow sink, 0 to never stall\n"
+               "                      (default: 10000)\n"
+               "  --stall-ns N        Duration of each stall (default: 1000000)\n"
+               "  --tsc               Timestamp records with the TSC clock\n"
+               "  --writers N         Writer threads of the async configurations (default: 1)\n";
+}
+
+bool parse(int argc, char** argv, options& opts)
+{
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg{argv[i]};
+    auto const next = [&] { return (i + 1 < argc) ? std::atoll(argv[++i]) : -1LL; };
+    if (arg == "--threads") {
+      opts.max_threads = static_cast<int>(next());
+    } else if (arg == "--messages") {
+      opts.messages = static_cast<int>(next());
+    } else if (arg == "--delay-ns") {
+      opts.delay = std::chrono::nanoseconds{next()};
+    } else if (arg == "--bandwidth") {
+      opts.bytes_per_second = static_cast<std::uint64_t>(next());
+    } else if (arg == "--stall-every") {
+      opts.stall_every = static_cast<int>(next());
+    } else if (arg == "--stall-ns") {
+      opts.stall = std::chrono::nanoseconds{next()};
+    } else if (arg == "--tsc") {
+      opts.tsc = true;
+    } else if (arg == "--writers") {
+      opts.writers = static_cast<int>(next());
+    } else {
+      return false;
+    }
+  }
+  return opts.max_threads > 0 && opts.messages > 0 && opts.writers > 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  options opts;
+  if (!parse(argc, argv, opts)) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  delay_model delays{opts};
+  callback_delays = &delays;
+  throttled_buf buf{delays};
+  std::ostream throttled{&buf};
+
+  // The null sink measures the cost of the logger itself; the others add a slow consumer. The
+  // slow consumers are also measured behind a stall guard and behind async writers, which both
+  // take the consumer off the logging threads. A stall guard drops records once it degrades, so
+  // its throughput is only comparable while no drops are reported.
+  auto const slow = [] { return std::make_shared<rapids_logger::callback_sink_mt>(slow_callback); };
+  auto const throttled_sink = [&] {
+    return std::make_shared<rapids_logger::ostream_sink_mt>(throttled);
+  };
+  std::vector<sink_config> sinks{
+    {"null_sink_mt", [] { return std::make_shared<rapids_logger::null_sink_mt>(); }},
+    {"callback_sink_mt (slow)", slow},
+    {"ostream_sink_mt (throttled)", throttled_sink},
+    {"stall_guard_sink_mt (slow)",
+     [&] { return std::make_shared<rapids_logger::stall_guard_sink_mt>(slow()); }},
+    {"stall_guard_sink_mt (throttled)",
+     [&] { return std::make_shared<rapids_logger::stall_guard_sink_mt>(throttled_sink()); }},
+    {"callback_sink_mt (slow, async)", slow, true},
+    {"ostream_sink_mt (throttled, async)", throttled_sink, true},
+  };
+
+  rapids_logger::async_options async;
+  async.writer_threads = static_cast<std::size_t>(opts.writers);
+  auto const clock =
+    opts.tsc ? rapids_logger::clock_source::tsc : rapids_logger::clock_source::system;
+
+  std::printf("%-36s %7s %12s %10s %10s %10s %10s %10s %10s\n",
+              "sink",
+              "threads",
+              "records/s",
+              "p50 ns",
+              "p90 ns",
+              "p99 ns",
+              "p99.9 ns",
+              "p99.99 ns",
+              "max ns");
+  for (auto const& config : sinks) {
+    for (int n_threads = 1;; n_threads = std::min(n_threads * 2, opts.max_threads)) {
+      auto logger = config.async
+                      ? rapids_logger::logger{"latency_bench", {config.make()}, async, clock}
+                      : rapids_logger::logger{"latency_bench", {config.make()}, clock};
+      double seconds{};
+      auto const h = run(logger, n_threads, opts.messages, seconds);
+      std::printf("%-36s %7d %12.0f %10lu %10lu %10lu %10lu %10lu %10lu\n",
+                  config.name.c_str(),
+                  n_threads,
+                  static_cast<double>(h.total()) / seconds,
+                  static_cast<unsigned long>(h.percentile(0.5)),
+                  static_cast<unsigned long>(h.percentile(0.9)),
+                  static_cast<unsigned long>(h.percentile(0.99)),
+                  static_cast<unsigned long>(h.percentile(0.999)),
+                  static_cast<unsigned long>(h.percentile(0.9999)),
+                  static_cast<unsigned long>(h.max()));
+      if (n_threads == opts.max_threads) { break; }
+    }
+  }
+  return EXIT_SUCCESS;
+}
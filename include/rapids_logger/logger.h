@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// The C API of rapids_logger, for C hosts and for bindings from other languages. Loggers are
+// accessed through opaque handles, and strings are passed as pointer and length pairs so that
+// callers never need to build NUL-terminated or C++ strings.
+#pragma once
+
+#include "log_levels.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef RAPIDS_LOGGER_EXPORT
+#define RAPIDS_LOGGER_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A handle to a logger.
+ *
+ * Handles are created and destroyed by the library. Only the logger's current level is exposed,
+ * so that RAPIDS_LOGGER_SHOULD_LOG can check it without a function call; the field must only be
+ * read, and only through that macro. No other fields will be added, so the layout is stable.
+ */
+typedef struct rapids_logger_handle {
+  int32_t level;  ///< The logger's level, one of the RAPIDS_LOGGER_LOG_LEVEL_* values
+} rapids_logger_handle;
+
+/**
+ * @brief A callback invoked with each NUL-terminated formatted record and its level.
+ */
+typedef void (*rapids_logger_log_callback_t)(int level, char const* message);
+
+/**
+ * @brief A callback invoked when a callback sink is flushed.
+ */
+typedef void (*rapids_logger_flush_callback_t)(void);
+
+/**
+ * @brief Check whether a logger would log a record at a level, without a function call.
+ *
+ * @param handle The logger
+ * @param lvl The level, one of the RAPIDS_LOGGER_LOG_LEVEL_* values
+ */
+#define RAPIDS_LOGGER_SHOULD_LOG(handle, lvl) \
+  ((lvl) >= __atomic_load_n(&(handle)->level, __ATOMIC_RELAXED))
+
+/**
+ * @brief Create a logger without any sinks.
+ *
+ * @param name The logger's name
+ * @param name_length The length of the name in bytes
+ * @return The logger, or NULL if it could not be created
+ */
+RAPIDS_LOGGER_EXPORT rapids_logger_handle* rapids_logger_create(char const* name,
+                                                                size_t name_length);
+
+/**
+ * @brief Destroy a logger, flushing its sinks.
+ *
+ * @param handle The logger, or NULL
+ */
+RAPIDS_LOGGER_EXPORT void rapids_logger_destroy(rapids_logger_handle* handle);
+
+/**
+ * @brief Add a sink that writes to stderr.
+ *
+ * @return 0 on success, nonzero on failure
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_add_stderr_sink(rapids_logger_handle* handle);
+
+/**
+ * @brief Add a sink that writes to a file.
+ *
+ * @param filename The path of the file
+ * @param filename_length The length of the path in bytes
+ * @param truncate Nonzero to truncate the file instead of appending to it
+ * @return 0 on success, nonzero on failure (e.g. if the file cannot be opened)
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_add_file_sink(rapids_logger_handle* handle,
+                                                     char const* filename,
+                                                     size_t filename_length,
+                                                     int truncate);
+
+/**
+ * @brief Add a sink that invokes a callback for every record.
+ *
+ * @param callback The callback receiving formatted records
+ * @param flush The callback invoked on flush, or NULL
+ * @return 0 on success, nonzero on failure
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_add_callback_sink(rapids_logger_handle* handle,
+                                                         rapids_logger_log_callback_t callback,
+                                                         rapids_logger_flush_callback_t flush);
+
+/**
+ * @brief Add a sink that discards every record.
+ *
+ * @return 0 on success, nonzero on failure
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_add_null_sink(rapids_logger_handle* handle);
+
+/**
+ * @brief Set the pattern used to format records for all of the logger's sinks.
+ *
+ * @param pattern The pattern, see rapids_logger::logger::set_pattern
+ * @param pattern_length The length of the pattern in bytes
+ * @return 0 on success, nonzero on failure
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_set_pattern(rapids_logger_handle* handle,
+                                                   char const* pattern,
+                                                   size_t pattern_length);
+
+/**
+ * @brief Set the logger's level.
+ *
+ * @param level One of the RAPIDS_LOGGER_LOG_LEVEL_* values
+ */
+RAPIDS_LOGGER_EXPORT void rapids_logger_set_level(rapids_logger_handle* handle, int32_t level);
+
+/**
+ * @brief Check whether the logger would log a record at a level.
+ *
+ * Equivalent to RAPIDS_LOGGER_SHOULD_LOG, for hosts that cannot use C macros.
+ *
+ * @return Nonzero if records at the level are logged
+ */
+RAPIDS_LOGGER_EXPORT int rapids_logger_should_log(rapids_logger_handle const* handle,
+                                                  int32_t level);
+
+/**
+ * @brief Log a message.
+ *
+ * The message does not need to be NUL-terminated and is not copied before formatting.
+ *
+ * @param level One of the RAPIDS_LOGGER_LOG_LEVEL_* values
+ * @param message The message
+ * @param message_length The length of the message in bytes
+ */
+RAPIDS_LOGGER_EXPORT void rapids_logger_log(rapids_logger_handle* handle,
+                                            int32_t level,
+                                            char const* message,
+                                            size_t message_length);
+
+/**
+ * @brief Flush the logger's sinks.
+ */
+RAPIDS_LOGGER_EXPORT void rapids_logger_flush(rapids_logger_handle* handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,9 +7,16 @@
 
 #include "log_levels.h"
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <memory>
 #include <ostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -46,6 +53,81 @@ DEFINE_ENUM_CLASS_OPERATOR(level_enum, <=);
 DEFINE_ENUM_CLASS_OPERATOR(level_enum, >);
 DEFINE_ENUM_CLASS_OPERATOR(level_enum, >=);
 
+/**
+ * @brief The clocks that a logger can use to timestamp records.
+ */
+enum class RAPIDS_LOGGER_EXPORT clock_source : int32_t {
+  system,  ///< std::chrono::system_clock, as used by spdlog
+  tsc,     ///< The CPU timestamp counter, periodically calibrated against the system clock
+};
+
+/**
+ * @brief What a logger with writer threads does with a record when its writer's queue is full.
+ */
+enum class RAPIDS_LOGGER_EXPORT overflow_policy : int32_t {
+  block,  ///< Wait until the writer has made room
+  drop,   ///< Discard the record and count it in the logger's metrics
+};
+
+/**
+ * @brief The configuration of a logger whose records are written by background threads.
+ *
+ * Each logging thread is assigned to one of the writers round-robin, on its first record, and
+ * hands its records to that writer's queue. Records from one thread are therefore written in
+ * order, but records from threads with different writers may be interleaved out of order.
+ *
+ * Writers can be pinned to specific CPUs, or to all CPUs of specific NUMA nodes, to keep them
+ * away from compute threads: writer i is pinned to cpus[i % cpus.size()] or to the CPUs of
+ * numa_nodes[i % numa_nodes.size()], and at most one of the two may be given. A pinned writer
+ * allocates its queue after pinning itself, so that the queue lives on the writer's NUMA node
+ * under the default first-touch policy.
+ *
+ * A record larger than queue_size never fits in a queue. With overflow_policy::block it is
+ * written on the logging thread, after the records queued before it; with overflow_policy::drop
+ * it is dropped.
+ */
+struct RAPIDS_LOGGER_EXPORT async_options {
+  std::size_t writer_threads{1};                     ///< The number of writer threads
+  std::size_t queue_size{1 << 20};                   ///< Bytes of records each writer can hold
+  std::vector<int> cpus;                             ///< CPUs to pin writers to, round-robin
+  std::vector<int> numa_nodes;                       ///< NUMA nodes to pin writers to, round-robin
+  overflow_policy overflow{overflow_policy::block};  ///< What to do when a queue is full
+};
+
+/**
+ * @brief A snapshot of the work done by a sink.
+ */
+struct RAPIDS_LOGGER_EXPORT sink_metrics {
+  /**
+   * @brief The number of buckets in the latency histogram.
+   *
+   * Bucket 0 counts writes that took less than a nanosecond, and bucket i > 0 counts writes that
+   * took at least 2^(i-1) and less than 2^i nanoseconds. The last bucket also counts every
+   * longer write.
+   */
+  static constexpr std::size_t latency_buckets = 32;
+
+  std::uint64_t messages{};  ///< Records written, not counting drops
+  std::uint64_t bytes{};     ///< Bytes of the records written, after formatting
+  std::uint64_t flushes{};   ///< Flushes requested
+  std::uint64_t drops{};     ///< Records discarded, for sinks that drop rather than block
+  std::array<std::uint64_t, latency_buckets> latency_histogram{};  ///< Time spent per write
+};
+
+/**
+ * @brief A snapshot of the work done by a logger.
+ *
+ * All counts are cumulative since the logger was constructed. The sink counts are cumulative
+ * since the sink was constructed and include records from every logger that shares the sink.
+ */
+struct RAPIDS_LOGGER_EXPORT logger_metrics {
+  /// Records logged, indexed by level
+  std::array<std::uint64_t, static_cast<std::size_t>(level_enum::n_levels)> messages{};
+  std::uint64_t filtered{};  ///< Records discarded because they were below the logger's level
+  std::uint64_t dropped{};   ///< Records or spans discarded by the logger itself, e.g. on overflow
+  std::vector<sink_metrics> sinks;  ///< Per-sink metrics, in the same order as sinks()
+};
+
 namespace detail {
 // Forward declare the implementation classes.
 class logger_impl;
@@ -175,13 +257,19 @@ class RAPIDS_LOGGER_EXPORT logger {
    * symbols publicly) and then invokes the base implementation with the
    * preformatted string.
    *
+   * Records below the current level are discarded before any formatting is
+   * done. Messages that fit in a small stack buffer are formatted without
+   * allocating; only unusually long messages fall back to the heap.
+   *
    * @param lvl The log level
    * @param format The format string
    * @param args The format arguments
    */
   template <typename... Args>
-  void log(level_enum lvl, std::string const& format, Args&&... args)
+  void log(level_enum lvl, char const* format, Args&&... args)
   {
+    if (!should_format(lvl)) { return; }
+
     auto convert_to_c_string = [](auto&& arg) -> decltype(auto) {
       using ArgType = std::decay_t<decltype(arg)>;
       if constexpr (std::is_same_v<ArgType, std::string>) {
@@ -191,30 +279,48 @@ class RAPIDS_LOGGER_EXPORT logger {
       }
     };
 
+    constexpr std::size_t stack_buffer_size = 512;
     // NOLINTBEGIN(cppcoreguidelines-pro-type-vararg)
-    auto formatted_size =
-      std::snprintf(nullptr, 0, format.c_str(), convert_to_c_string(std::forward<Args>(args))...);
+    // NOLINTNEXTLINE(modernize-avoid-c-arrays, cppcoreguidelines-avoid-c-arrays)
+    char stack_buf[stack_buffer_size];
+    auto formatted_size = std::snprintf(
+      stack_buf, stack_buffer_size, format, convert_to_c_string(std::forward<Args>(args))...);
     if (formatted_size < 0) { throw std::runtime_error("Error during formatting."); }
-    if (formatted_size == 0) { log(lvl, {}); }
-    auto size = static_cast<std::size_t>(formatted_size) + 1;  // for null terminator
+    auto size = static_cast<std::size_t>(formatted_size);
+    if (size < stack_buffer_size) {
+      log(lvl, std::string_view{stack_buf, size});
+      return;
+    }
     // NOLINTNEXTLINE(modernize-avoid-c-arrays, cppcoreguidelines-avoid-c-arrays)
-    std::unique_ptr<char[]> buf(new char[size]);
-    std::snprintf(
-      buf.get(), size, format.c_str(), convert_to_c_string(std::forward<Args>(args))...);
+    std::unique_ptr<char[]> buf(new char[size + 1]);  // for null terminator
+    std::snprintf(buf.get(), size + 1, format, convert_to_c_string(std::forward<Args>(args))...);
     // NOLINTEND(cppcoreguidelines-pro-type-vararg)
-    log(lvl, {buf.get(), buf.get() + size - 1});  // drop '\0'
+    log(lvl, std::string_view{buf.get(), size});
   };
 
   /**
-   * @brief Log a message at the TRACE level.
+   * @brief Format and log a message at the specified level.
    *
+   * @param lvl The log level
    * @param format The format string
    * @param args The format arguments
    */
   template <typename... Args>
-  void trace(std::string const& format, Args&&... args)
+  void log(level_enum lvl, std::string const& format, Args&&... args)
+  {
+    log(lvl, format.c_str(), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Log a message at the TRACE level.
+   *
+   * @param format The format string
+   * @param args The format arguments
+   */
+  template <typename Format, typename... Args>
+  void trace(Format&& format, Args&&... args)
   {
-    log(level_enum::trace, format, std::forward<Args>(args)...);
+    log(level_enum::trace, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
@@ -223,10 +329,10 @@ class RAPIDS_LOGGER_EXPORT logger {
    * @param format The format string
    * @param args The format arguments
    */
-  template <typename... Args>
-  void debug(std::string const& format, Args&&... args)
+  template <typename Format, typename... Args>
+  void debug(Format&& format, Args&&... args)
   {
-    log(level_enum::debug, format, std::forward<Args>(args)...);
+    log(level_enum::debug, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
@@ -235,10 +341,10 @@ class RAPIDS_LOGGER_EXPORT logger {
    * @param format The format string
    * @param args The format arguments
    */
-  template <typename... Args>
-  void info(std::string const& format, Args&&... args)
+  template <typename Format, typename... Args>
+  void info(Format&& format, Args&&... args)
   {
-    log(level_enum::info, format, std::forward<Args>(args)...);
+    log(level_enum::info, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
@@ -247,10 +353,10 @@ class RAPIDS_LOGGER_EXPORT logger {
    * @param format The format string
    * @param args The format arguments
    */
-  template <typename... Args>
-  void warn(std::string const& format, Args&&... args)
+  template <typename Format, typename... Args>
+  void warn(Format&& format, Args&&... args)
   {
-    log(level_enum::warn, format, std::forward<Args>(args)...);
+    log(level_enum::warn, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
@@ -259,10 +365,10 @@ class RAPIDS_LOGGER_EXPORT logger {
    * @param format The format string
    * @param args The format arguments
    */
-  template <typename... Args>
-  void error(std::string const& format, Args&&... args)
+  template <typename Format, typename... Args>
+  void error(Format&& format, Args&&... args)
   {
-    log(level_enum::error, format, std::forward<Args>(args)...);
+    log(level_enum::error, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
@@ -271,17 +377,18 @@ class RAPIDS_LOGGER_EXPORT logger {
    * @param format The format string
    * @param args The format arguments
    */
-  template <typename... Args>
-  void critical(std::string const& format, Args&&... args)
+  template <typename Format, typename... Args>
+  void critical(Format&& format, Args&&... args)
   {
-    log(level_enum::critical, format, std::forward<Args>(args)...);
+    log(level_enum::critical, std::forward<Format>(format), std::forward<Args>(args)...);
   }
 
   /**
    * @brief Construct a new logger object
    *
    * @param name The name of the logger
-   * @param filename The name of the log file
+   * @param filename The name of the log file, which may contain the placeholders supported by
+   * basic_file_sink_mt
    */
   logger(std::string name, std::string filename);
 
@@ -306,6 +413,45 @@ class RAPIDS_LOGGER_EXPORT logger {
    */
   logger(std::string name, std::vector<sink_ptr> sinks);
 
+  /**
+   * @brief Construct a new logger object with a specific timestamp clock
+   *
+   * With clock_source::tsc, records are timestamped by reading the CPU timestamp counter and
+   * converting it to wall time, which avoids a potentially slow system clock read per record.
+   * Timestamps are monotonic per thread. Hosts without a constant-rate counter fall back to the
+   * system clock.
+   *
+   * @param name The name of the logger
+   * @param sinks The sinks to log to
+   * @param clock The clock used to timestamp records
+   */
+  logger(std::string name, std::vector<sink_ptr> sinks, clock_source clock);
+
+  /**
+   * @brief Construct a new logger object that writes records from background threads
+   *
+   * Logging a record only timestamps it and copies it, along with the thread's context_scope
+   * fields, into a writer's queue; the writer formats it and writes it to the sinks. With
+   * clock_source::tsc, converting the timestamp to wall time is also left to the writer.
+   * flush() waits for the records logged before it to be written. If the logger is registered
+   * with flush_on_crash(), the crash handler writes the records still queued to the buffered
+   * sinks after their buffers, as their level and message without the logger's pattern. A record
+   * that a writer was writing when the process crashed may appear twice.
+   *
+   * @param name The name of the logger
+   * @param sinks The sinks to log to
+   * @param options The configuration of the writers
+   * @param clock The clock used to timestamp records
+   *
+   * @throws std::invalid_argument if the options are invalid, e.g. name a NUMA node that does not
+   * exist
+   * @throws std::system_error if a writer cannot be pinned to its CPUs
+   */
+  logger(std::string name,
+         std::vector<sink_ptr> sinks,
+         async_options const& options,
+         clock_source clock = clock_source::system);
+
   /**
    * @brief Destroy the logger object
    */
@@ -321,6 +467,27 @@ class RAPIDS_LOGGER_EXPORT logger {
    */
   void log(level_enum lvl, std::string const& message);
 
+  /**
+   * @brief Log a message at the specified level.
+   *
+   * Unlike the std::string overload, this does not require the caller to
+   * materialize a std::string, so no allocation is needed for the message.
+   *
+   * @param lvl The log level
+   * @param message The message to log
+   */
+  void log(level_enum lvl, std::string_view message);
+
+  /**
+   * @brief Log a null-terminated message at the specified level.
+   *
+   * The message is logged verbatim; no printf-style formatting is applied.
+   *
+   * @param lvl The log level
+   * @param message The message to log
+   */
+  void log(level_enum lvl, char const* message);
+
   /**
    * @brief Get the sinks for the logger.
    *
@@ -364,6 +531,19 @@ class RAPIDS_LOGGER_EXPORT logger {
    */
   level_enum flush_level() const;
 
+  /**
+   * @brief Set whether the crash handler writes out this logger's buffered records.
+   *
+   * Together with install_crash_handler(), this keeps the last records before a crash without
+   * having to flush on every record. The logger is unregistered when it is destroyed. Up to 16
+   * buffered sinks of the logger are written out.
+   *
+   * @param enable Whether to flush the logger's sinks on a crash
+   *
+   * @throws std::length_error if too many loggers are already registered
+   */
+  void flush_on_crash(bool enable = true);
+
   /**
    * @brief Check if the logger should log a message at the specified level.
    *
@@ -372,16 +552,53 @@ class RAPIDS_LOGGER_EXPORT logger {
    */
   bool should_log(level_enum msg_level) const;
 
+  /**
+   * @brief Get a snapshot of the logger's metrics.
+   *
+   * Counters are sharded across threads, so logging never contends on them; taking a snapshot
+   * sums the shards and is intended to be done periodically rather than on a hot path.
+   *
+   * @return The metrics
+   */
+  logger_metrics metrics() const;
+
+  /**
+   * @brief Get the clock used to timestamp records.
+   *
+   * @return The clock source
+   */
+  clock_source clock() const;
+
   /**
    * @brief Set the pattern for the logger.
    *
+   * The pattern applies to all of the logger's sinks, including sinks added later. Each record
+   * is formatted once and the result is shared by all sinks that write formatted text.
+   *
+   * In addition to spdlog's pattern flags, `%&` renders the fields of the logging thread's
+   * context_scope instances.
+   *
    * @param pattern The pattern to use
    */
   void set_pattern(std::string pattern);
 
  private:
+  /**
+   * @brief Check whether a record at the specified level should be formatted and logged.
+   *
+   * Records that are rejected are counted as filtered in the logger's metrics.
+   *
+   * @param lvl The level of the record
+   * @return true if the record should be logged, false otherwise
+   */
+  bool should_format(level_enum lvl);
+
   std::unique_ptr<detail::logger_impl> impl;  ///< The logger implementation
   sink_vector sinks_;                         ///< The sinks for the logger
+  // Spans and buffered records are kept for the logger implementation, which outlives moves of
+  // the logger.
+  friend class span_scope;
+  friend class buffered_scope;
 };
 
 /**
@@ -394,21 +611,163 @@ class RAPIDS_LOGGER_EXPORT sink {
  public:
   ~sink();
 
+  /**
+   * @brief Get a snapshot of the sink's metrics.
+   *
+   * @return The metrics
+   */
+  sink_metrics metrics() const;
+
+  /**
+   * @brief Set the minimum level of records written by this sink.
+   *
+   * Records below this level are skipped before they are formatted, independently of the
+   * level of any logger using the sink. The default is level_enum::trace.
+   *
+   * @param log_level The new log level
+   */
+  void set_level(level_enum log_level);
+
+  /**
+   * @brief Get the minimum level of records written by this sink.
+   *
+   * @return The log level
+   */
+  level_enum level() const;
+
  protected:
   explicit sink(std::unique_ptr<detail::sink_impl> impl);
   std::unique_ptr<detail::sink_impl> impl;
   // The sink vector needs to be able to pass the underlying sink to the spdlog logger.
   friend class logger::sink_vector;
+  // The stall guard needs to be able to write to the sink it decorates.
+  friend class stall_guard_sink_mt;
 };
 
 /**
  * @brief A sink that writes to a file.
  *
  * See spdlog::sinks::basic_file_sink_mt for more information.
+ *
+ * So that every process of a multi-process job can use the same file name, the name may contain
+ * the placeholders `{pid}` (the process id), `{hostname}` (the host name), and `{rank}` (the
+ * process's rank, read from the first of the RAPIDS_LOGGER_RANK, OMPI_COMM_WORLD_RANK, PMI_RANK
+ * and SLURM_PROCID environment variables that is set, or 0). The rapids_logger_merge tool merges
+ * the resulting files into one, ordered by timestamp.
+ *
+ * Records are buffered in memory and written to the file when the buffer is full or the logger
+ * is flushed. By default the buffer has the file's block size, as a stdio FILE would. A larger
+ * buffer writes less often, at the cost of a reader following the file seeing records in larger
+ * batches, and of losing more records if the process crashes without install_crash_handler().
+ * Use logger::flush_on() to write records of a given level immediately.
  */
 class RAPIDS_LOGGER_EXPORT basic_file_sink_mt : public sink {
  public:
   basic_file_sink_mt(std::string const& filename, bool truncate = false);
+
+  /**
+   * @brief Construct a file sink with a buffer of the given size.
+   *
+   * @param filename The file name, which may contain placeholders
+   * @param truncate Whether to truncate the file
+   * @param buffer_size The number of bytes of records to buffer, e.g. 1 << 16, or 0 for the
+   * file's block size
+   */
+  basic_file_sink_mt(std::string const& filename, bool truncate, std::size_t buffer_size);
+};
+
+/**
+ * @brief A sink that writes gzip-compressed output to a file.
+ *
+ * Records are collected into large batches that are compressed and written on a background
+ * thread, so logging threads never compress. flush() compresses everything logged so far and
+ * ends it with a sync point, so the file can be decompressed up to that point even if the
+ * stream is never finished. When appending to an existing file, a new gzip member is started.
+ *
+ * The file name may contain the same placeholders as basic_file_sink_mt's.
+ *
+ * This sink is only available if rapids_logger was built with zlib.
+ *
+ * @throws std::runtime_error if rapids_logger was built without zlib or the file cannot be
+ * opened
+ */
+class RAPIDS_LOGGER_EXPORT compressed_file_sink_mt : public sink {
+ public:
+  compressed_file_sink_mt(std::string const& filename,
+                          bool truncate         = false,
+                          int compression_level = 6);
+};
+
+/**
+ * @brief A sink that publishes records to a ring buffer in shared memory.
+ *
+ * The ring is created as `/dev/shm/<name>.<pid>` and is drained, together with the rings of
+ * every other process using the same name, by the rapids_logger_collector tool, which merges
+ * them into a single output ordered by timestamp. Writing a record is a copy into the ring and
+ * an atomic store, with no syscalls. If the ring is full because the collector is slow or not
+ * running, records are dropped and counted in the sink's metrics instead of blocking.
+ *
+ * The collector removes a ring once it has drained it and its process has exited. If no
+ * collector ever runs, the ring is left behind in `/dev/shm` until it is removed by hand or the
+ * system restarts.
+ *
+ * A ring has a single writer, so only one sink of a process may use a name at a time. A ring
+ * left behind under the same name, by an earlier sink of the process or an earlier process with
+ * the same pid, is replaced.
+ *
+ * @throws std::runtime_error if another sink of the process uses the name or the ring cannot be
+ * created
+ */
+class RAPIDS_LOGGER_EXPORT shm_ring_sink_mt : public sink {
+ public:
+  explicit shm_ring_sink_mt(std::string const& name, std::size_t capacity = 1 << 22);
+};
+
+/**
+ * @brief A sink that forwards records to a Unix domain socket, such as a node-local agent.
+ *
+ * Logging only appends the formatted record to a bounded pending buffer. A background thread
+ * sends the buffer in batches using non-blocking I/O, as stream writes or as datagrams of whole
+ * records, and reconnects with exponential backoff while the socket is unavailable. When the
+ * receiver stalls or is gone and the pending buffer is full, records are dropped and counted in
+ * the sink's metrics, so logging threads never block on the receiver. flush() sends pending
+ * records immediately but does not wait for them to be delivered. Destroying the sink waits up to
+ * one second for the records it still holds to be delivered; the rest are dropped.
+ *
+ * @param path The filesystem path of the socket
+ * @param datagram Whether to connect with SOCK_DGRAM instead of SOCK_STREAM
+ * @param buffer_size The maximum number of bytes pending delivery
+ *
+ * @throws std::invalid_argument if the path is too long for a Unix domain socket
+ */
+class RAPIDS_LOGGER_EXPORT unix_socket_sink_mt : public sink {
+ public:
+  explicit unix_socket_sink_mt(std::string const& path,
+                               bool datagram           = false,
+                               std::size_t buffer_size = 1 << 20);
+};
+
+/**
+ * @brief A sink that writes a trace in the Chrome trace event format.
+ *
+ * The file can be opened in Perfetto (https://ui.perfetto.dev) or chrome://tracing. Spans
+ * recorded with span_scope become complete ("X") events, and log records become instant ("i")
+ * events named after the formatted record, on the thread that logged them. Events are buffered
+ * in memory and written when the buffer fills up or the sink is flushed. The JSON array is closed
+ * when the sink is destroyed; the viewers also accept a trace that was cut off by a crash. Spans
+ * are handed to the sink when the logger is flushed (see span_scope), and spans not yet handed
+ * over when the process crashes are lost.
+ *
+ * The file name may contain the same placeholders as basic_file_sink_mt. An existing file is
+ * truncated.
+ *
+ * @param filename The file to write the trace to
+ *
+ * @throws std::runtime_error if the file cannot be opened
+ */
+class RAPIDS_LOGGER_EXPORT chrome_trace_sink_mt : public sink {
+ public:
+  explicit chrome_trace_sink_mt(std::string const& filename);
 };
 
 /**
@@ -453,6 +812,64 @@ class RAPIDS_LOGGER_EXPORT callback_sink_mt : public sink {
                             const flush_callback_t& flush = nullptr);
 };
 
+/**
+ * @brief Install handlers for SIGSEGV, SIGABRT and SIGBUS that flush loggers before the crash.
+ *
+ * On a fatal signal, the handler writes the records buffered by the sinks of every logger
+ * registered with logger::flush_on_crash() directly to their file descriptors, using only
+ * async-signal-safe operations. It then restores the previously installed handlers and
+ * re-raises the signal, so the process terminates (or chains to the previous handler) as it
+ * would have otherwise.
+ *
+ * File sinks are written out. Sinks that are unbuffered (stderr, shared memory rings) need no
+ * flushing, and sinks whose output cannot be written safely from a signal handler (ostreams,
+ * callbacks, compressed files, sockets) are skipped. Installing the handlers more than once has
+ * no effect.
+ *
+ * The handler runs on an alternate signal stack, so that it also runs when a thread overflows
+ * its stack. The stack is set up for the thread that installs the handler and for every thread
+ * the first time it logs a record that is not filtered out, unless the thread already has an
+ * alternate stack. Other threads that crash by overflowing their stack are not flushed. If
+ * several threads crash at once, the first one flushes while the others wait for it.
+ */
+RAPIDS_LOGGER_EXPORT void install_crash_handler();
+
+typedef void (*stall_callback_t)(bool degraded);
+
+/**
+ * @brief A sink that protects logging threads from another sink that stalls.
+ *
+ * Records are queued and written to the decorated sink by a dedicated thread, so logging threads
+ * never wait on it. If a single write to the decorated sink takes longer than the latency
+ * budget (e.g. stderr is a full pipe, or a network filesystem hangs), or the queue overflows,
+ * the guard becomes degraded: records below error are dropped and counted in the sink's metrics,
+ * while error and critical records are always queued. Once the decorated sink has caught up with
+ * the queue, the guard recovers on its own. Both transitions are reported through the callback,
+ * which is invoked from a monitoring thread.
+ *
+ * flush() waits at most one latency budget for the queue to be written and the decorated sink
+ * to be flushed, without holding up other threads logging to the guard; while the guard is
+ * degraded it only asks the writer to flush and returns at once. Destroying the guard also waits
+ * at most one latency budget for the queued records to be written; if the decorated sink is
+ * still stalled, the remaining records are dropped and the write in progress is left to finish
+ * in the background. Errors thrown by the decorated sink are reported through the error handler
+ * of the logger that next writes to or flushes the guard.
+ *
+ * @param wrapped The sink to protect
+ * @param latency_budget The longest a write to the decorated sink may take before the guard
+ * degrades
+ * @param callback Invoked with true when the guard degrades and false when it recovers, or null
+ * @param queue_size The maximum number of bytes of records below error that may be queued
+ */
+class RAPIDS_LOGGER_EXPORT stall_guard_sink_mt : public sink {
+ public:
+  explicit stall_guard_sink_mt(
+    sink_ptr const& wrapped,
+    std::chrono::microseconds latency_budget = std::chrono::milliseconds{100},
+    stall_callback_t callback                = nullptr,
+    std::size_t queue_size                   = 1 << 20);
+};
+
 /**
  * @brief An object used for scoped log level setting
  *
@@ -472,4 +889,141 @@ struct RAPIDS_LOGGER_EXPORT log_level_setter {
   level_enum prev_level_;
 };
 
+/**
+ * @brief An object used to attach a diagnostic context field to records.
+ *
+ * While an instance is alive, every record logged by the constructing thread carries the field,
+ * which is rendered by the `%&` pattern flag as space-separated `key:value` pairs, e.g.
+ * `logger.set_pattern("[%l] [%&] %v")`. Scopes nest and must be destroyed in reverse order of
+ * construction, which is automatic for local variables.
+ *
+ * The fields are stored inline in fixed-size thread-local storage, so creating a scope never
+ * allocates. Fields that do not fit (beyond 8 fields or 256 bytes of rendered text) are omitted.
+ */
+class RAPIDS_LOGGER_EXPORT context_scope {
+ public:
+  /**
+   * @brief Attach a field to the calling thread's records.
+   *
+   * @param key The field name
+   * @param value The field value
+   */
+  context_scope(std::string_view key, std::string_view value);
+
+  /**
+   * @brief Attach an integer field to the calling thread's records.
+   *
+   * @param key The field name
+   * @param value The field value
+   */
+  context_scope(std::string_view key, std::int64_t value);
+
+  ~context_scope();
+
+  context_scope(context_scope const&)            = delete;
+  context_scope& operator=(context_scope const&) = delete;
+  context_scope(context_scope&&)                 = delete;
+  context_scope& operator=(context_scope&&)      = delete;
+
+ private:
+  bool pushed_;  ///< Whether the field fit and must be removed on destruction
+};
+
+/**
+ * @brief An object used to time a scope for a trace.
+ *
+ * The span starts when the object is constructed and ends when it is destroyed. If the logger
+ * logs at the span's level, the span is recorded with the name, the calling thread, and its start
+ * and end time, and written by the logger's chrome_trace_sink_mt sinks the next time the logger
+ * is flushed, whether by flush(), by a record at or above the flush_on() level, or when the
+ * logger is destroyed. Otherwise the span does nothing. Spans are not written by the crash
+ * handler, so the spans recorded since the last flush are lost on a crash.
+ *
+ * Timing is done with the CPU timestamp counter where it is usable, and completed spans are kept
+ * in a fixed-size buffer per thread until the logger is flushed, so a span costs two counter
+ * reads and does not lock or allocate once its thread has recorded a span. Spans that do not fit
+ * in the buffer are dropped and counted in the logger's metrics. The `*_SPAN_*` macros generated
+ * alongside the logging macros create a span for the default logger, and compile away below the
+ * active level.
+ *
+ * @param logger The logger to record the span for, which must outlive the span
+ * @param lvl The level of the span
+ * @param name The name of the span, which is not copied and must outlive the logger (e.g. a
+ * string literal)
+ */
+class RAPIDS_LOGGER_EXPORT span_scope {
+ public:
+  span_scope(logger& logger, level_enum lvl, char const* name);
+  ~span_scope();
+
+  span_scope(span_scope const&)            = delete;
+  span_scope& operator=(span_scope const&) = delete;
+  span_scope(span_scope&&)                 = delete;
+  span_scope& operator=(span_scope&&)      = delete;
+
+ private:
+  std::uint64_t owner_;  ///< The logger's span owner, or 0 if the span is not recorded
+  char const* name_;
+  level_enum level_;
+  std::uint64_t start_;
+};
+
+/**
+ * @brief An object used to keep a unit of work's low-level records in case the work fails.
+ *
+ * While an instance is alive, records that the calling thread logs to the logger below the
+ * logger's level are kept in a thread-local arena instead of being discarded. When the scope
+ * ends, they are written to the logger's sinks, with their original timestamps and context
+ * fields, if fail() was called or a record at level_enum::error or above was logged within the
+ * scope. Otherwise they are discarded by resetting the arena, without ever being formatted with
+ * the logger's pattern.
+ *
+ * Note that the printf-style substitution of a record's arguments is still done when the record
+ * is logged, since the arguments may not outlive the call, and that records removed at compile
+ * time by the logging macros' active level cannot be kept. Records at or above the logger's level
+ * are written immediately as usual.
+ *
+ * Scopes may be nested; records are kept by the innermost scope only, and only if it belongs to
+ * the logger being logged to. A record at level_enum::error or above fails every enclosing scope
+ * of its logger, while fail() only fails the scope it is called on. Records that do not fit in
+ * the scope's capacity are dropped and counted in the logger's metrics. The arena is reused by
+ * later scopes on the same thread, so scopes only allocate when they need more capacity than any
+ * earlier scope.
+ *
+ * @param logger The logger whose records to keep, which must outlive the scope
+ * @param capacity The number of bytes of records that the scope can keep
+ */
+class RAPIDS_LOGGER_EXPORT buffered_scope {
+ public:
+  explicit buffered_scope(logger& logger, std::size_t capacity = 1 << 16);
+  ~buffered_scope();
+
+  buffered_scope(buffered_scope const&)            = delete;
+  buffered_scope& operator=(buffered_scope const&) = delete;
+  buffered_scope(buffered_scope&&)                 = delete;
+  buffered_scope& operator=(buffered_scope&&)      = delete;
+
+  /**
+   * @brief Mark the unit of work as failed, so that the kept records are written.
+   */
+  void fail() noexcept { failed_ = true; }
+
+  /**
+   * @brief Check whether the kept records will be written when the scope ends.
+   *
+   * @return true if fail() was called or an error was logged within the scope
+   */
+  bool failed() const noexcept { return failed_; }
+
+ private:
+  friend class detail::logger_impl;
+
+  detail::logger_impl* impl_;  ///< The logger whose records are kept
+  buffered_scope* parent_;     ///< The enclosing scope on this thread, if any
+  std::size_t begin_;          ///< Start of the scope's records in the thread's arena
+  std::size_t end_;            ///< End of the space available to the scope in the arena
+  std::size_t records_{0};     ///< The number of records kept
+  bool failed_{false};
+};
+
 }  // namespace rapids_logger
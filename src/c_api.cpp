@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.h>
+#include <rapids_logger/logger.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+/**
+ * @brief The object behind a C handle.
+ *
+ * The public part of the handle is the base class, so that handles convert to this type with a
+ * static_cast.
+ */
+struct c_logger : public rapids_logger_handle {
+  explicit c_logger(std::string name)
+    : rapids_logger_handle{}, logger_{std::move(name), std::vector<sink_ptr>{}}
+  {
+    publish_level();
+  }
+
+  /**
+   * @brief Mirror the logger's level into the handle for RAPIDS_LOGGER_SHOULD_LOG.
+   */
+  void publish_level()
+  {
+    std::atomic_ref<std::int32_t>{level}.store(static_cast<std::int32_t>(logger_.level()),
+                                               std::memory_order_relaxed);
+  }
+
+  rapids_logger::logger logger_;
+};
+
+c_logger& from_handle(rapids_logger_handle* handle) { return static_cast<c_logger&>(*handle); }
+
+bool valid_level(std::int32_t level)
+{
+  return level >= RAPIDS_LOGGER_LOG_LEVEL_TRACE && level <= RAPIDS_LOGGER_LOG_LEVEL_OFF;
+}
+
+/**
+ * @brief Run a function, converting any exception into a nonzero status code.
+ */
+template <typename F>
+int to_status(F&& f) noexcept
+{
+  try {
+    f();
+    return 0;
+  } catch (...) {
+    return 1;
+  }
+}
+
+}  // namespace
+}  // namespace detail
+}  // namespace rapids_logger
+
+using rapids_logger::detail::from_handle;
+using rapids_logger::detail::to_status;
+
+extern "C" {
+
+rapids_logger_handle* rapids_logger_create(char const* name, size_t name_length)
+{
+  try {
+    return new rapids_logger::detail::c_logger{std::string{name, name_length}};
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void rapids_logger_destroy(rapids_logger_handle* handle)
+{
+  if (handle == nullptr) { return; }
+  try {
+    from_handle(handle).logger_.flush();
+  } catch (...) {
+    // The logger is destroyed regardless; a failed flush has nowhere to be reported.
+  }
+  delete &from_handle(handle);
+}
+
+int rapids_logger_add_stderr_sink(rapids_logger_handle* handle)
+{
+  return to_status([&] {
+    from_handle(handle).logger_.sinks().push_back(
+      std::make_shared<rapids_logger::stderr_sink_mt>());
+  });
+}
+
+int rapids_logger_add_file_sink(rapids_logger_handle* handle,
+                                char const* filename,
+                                size_t filename_length,
+                                int truncate)
+{
+  return to_status([&] {
+    from_handle(handle).logger_.sinks().push_back(
+      std::make_shared<rapids_logger::basic_file_sink_mt>(std::string{filename, filename_length},
+                                                          truncate != 0));
+  });
+}
+
+int rapids_logger_add_callback_sink(rapids_logger_handle* handle,
+                                    rapids_logger_log_callback_t callback,
+                                    rapids_logger_flush_callback_t flush)
+{
+  return to_status([&] {
+    from_handle(handle).logger_.sinks().push_back(
+      std::make_shared<rapids_logger::callback_sink_mt>(callback, flush));
+  });
+}
+
+int rapids_logger_add_null_sink(rapids_logger_handle* handle)
+{
+  return to_status([&] {
+    from_handle(handle).logger_.sinks().push_back(std::make_shared<rapids_logger::null_sink_mt>());
+  });
+}
+
+int rapids_logger_set_pattern(rapids_logger_handle* handle,
+                              char const* pattern,
+                              size_t pattern_length)
+{
+  return to_status(
+    [&] { from_handle(handle).logger_.set_pattern(std::string{pattern, pattern_length}); });
+}
+
+void rapids_logger_set_level(rapids_logger_handle* handle, int32_t level)
+{
+  if (!rapids_logger::detail::valid_level(level)) { return; }
+  auto& logger = from_handle(handle);
+  logger.logger_.set_level(static_cast<rapids_logger::level_enum>(level));
+  logger.publish_level();
+}
+
+int rapids_logger_should_log(rapids_logger_handle const* handle, int32_t level)
+{
+  return RAPIDS_LOGGER_SHOULD_LOG(handle, level) ? 1 : 0;
+}
+
+void rapids_logger_log(rapids_logger_handle* handle,
+                       int32_t level,
+                       char const* message,
+                       size_t message_length)
+{
+  // Levels above critical would index past spdlog's level names.
+  if (level < RAPIDS_LOGGER_LOG_LEVEL_TRACE || level >= RAPIDS_LOGGER_LOG_LEVEL_OFF) { return; }
+  try {
+    from_handle(handle).logger_.log(static_cast<rapids_logger::level_enum>(level),
+                                    std::string_view{message, message_length});
+  } catch (...) {
+    // Exceptions must not cross the C boundary, and a failed log has nowhere to be reported.
+  }
+}
+
+void rapids_logger_flush(rapids_logger_handle* handle)
+{
+  try {
+    from_handle(handle).logger_.flush();
+  } catch (...) {
+  }
+}
+
+}  // extern "C"
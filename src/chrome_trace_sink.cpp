@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/crash_flush.hpp"
+#include "detail/filename.hpp"
+#include "detail/sink_impl.hpp"
+#include "detail/spans.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+// Pending events are written once they exceed this size.
+constexpr std::size_t write_threshold = 1 << 16;
+
+/**
+ * @brief Append a string to a JSON document as a quoted, escaped string.
+ */
+void append_json_string(std::string& out, std::string_view text)
+{
+  constexpr char hex[] = "0123456789abcdef";
+  out += '"';
+  for (auto const c : text) {
+    auto const u = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (u < 0x20) {
+      out += "\\u00";
+      out += hex[u >> 4];
+      out += hex[u & 0xf];
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+void append_number(std::string& out, std::uint64_t value)
+{
+  char digits[20];
+  auto const end = std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+  out.append(digits, end);
+}
+
+/**
+ * @brief Append a time as the microseconds since the epoch that trace events are stamped with.
+ */
+void append_microseconds(std::string& out, std::chrono::nanoseconds ns)
+{
+  auto const count = static_cast<std::uint64_t>(std::max<std::int64_t>(ns.count(), 0));
+  append_number(out, count / 1000);
+  auto const fraction = count % 1000;
+  out += '.';
+  out += static_cast<char>('0' + fraction / 100);
+  out += static_cast<char>('0' + fraction / 10 % 10);
+  out += static_cast<char>('0' + fraction % 10);
+}
+
+std::chrono::nanoseconds since_epoch(std::chrono::system_clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch());
+}
+
+/**
+ * @brief A sink that writes spans and records as Chrome trace events.
+ *
+ * The file is a JSON array of events. Events are accumulated as text and written with a single
+ * write(2) once enough are pending or the sink is flushed.
+ */
+template <class Mutex>
+class chrome_trace_sink : public formatting_sink<Mutex>, public span_writer {
+ public:
+  explicit chrome_trace_sink(std::string const& filename)
+    : filename_{expand_filename(filename)}, pid_{static_cast<std::uint64_t>(::getpid())}
+  {
+    auto const parent = std::filesystem::path{filename_}.parent_path();
+    if (!parent.empty()) { std::filesystem::create_directories(parent); }
+    fd_ = ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      auto const error = errno;
+      throw std::runtime_error("Failed opening file " + filename_ + " for writing: " +
+                               std::strerror(error));
+    }
+    pending_.reserve(2 * write_threshold);
+    pending_ = "[";
+  }
+
+  ~chrome_trace_sink() override
+  {
+    pending_ += "\n]\n";
+    write_all(fd_, pending_.data(), pending_.size());
+    ::close(fd_);
+  }
+
+  chrome_trace_sink(chrome_trace_sink const&)            = delete;
+  chrome_trace_sink& operator=(chrome_trace_sink const&) = delete;
+
+  void write_spans(std::string_view logger_name, std::vector<span_event> const& events) override
+  {
+    std::lock_guard<Mutex> lock(spdlog::sinks::base_sink<Mutex>::mutex_);
+    for (auto const& event : events) {
+      if (!this->should_log(static_cast<spdlog::level::level_enum>(event.level))) { continue; }
+      auto const start = since_epoch(span_time(event.start));
+      auto const end   = since_epoch(span_time(event.end));
+      begin_event(event.name, logger_name, "X", start, event.thread_id);
+      pending_ += ",\"dur\":";
+      append_microseconds(pending_, std::max(end - start, std::chrono::nanoseconds{0}));
+      pending_ += '}';
+    }
+    if (pending_.size() >= write_threshold) { write_pending(); }
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) override
+  {
+    std::string_view text{formatted.data(), formatted.size()};
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+      text.remove_suffix(1);
+    }
+    auto const level = spdlog::level::to_string_view(msg.level);
+    begin_event(text,
+                {msg.logger_name.data(), msg.logger_name.size()},
+                "i",
+                since_epoch(msg.time),
+                msg.thread_id);
+    pending_ += ",\"s\":\"t\",\"args\":{\"level\":";
+    append_json_string(pending_, {level.data(), level.size()});
+    pending_ += "}}";
+    if (pending_.size() >= write_threshold) { write_pending(); }
+    return true;
+  }
+
+  void flush_() override { write_pending(); }
+
+ private:
+  /**
+   * @brief Append the fields common to all events, leaving the event open for more fields.
+   */
+  void begin_event(std::string_view name,
+                   std::string_view category,
+                   char const* phase,
+                   std::chrono::nanoseconds timestamp,
+                   std::size_t thread_id)
+  {
+    pending_ += first_event_ ? "\n{\"name\":" : ",\n{\"name\":";
+    first_event_ = false;
+    append_json_string(pending_, name);
+    pending_ += ",\"cat\":";
+    append_json_string(pending_, category);
+    pending_ += ",\"ph\":\"";
+    pending_ += phase;
+    pending_ += "\",\"ts\":";
+    append_microseconds(pending_, timestamp);
+    pending_ += ",\"pid\":";
+    append_number(pending_, pid_);
+    pending_ += ",\"tid\":";
+    append_number(pending_, thread_id);
+  }
+
+  void write_pending()
+  {
+    if (pending_.empty()) { return; }
+    auto const written = write_all(fd_, pending_.data(), pending_.size());
+    pending_.clear();
+    if (!written) {
+      auto const error = errno;
+      throw std::runtime_error("Failed writing to file " + filename_ + ": " +
+                               std::strerror(error));
+    }
+  }
+
+  std::string filename_;
+  int fd_{-1};
+  std::uint64_t pid_;
+  std::string pending_;  ///< Events not yet written to the file
+  bool first_event_{true};
+};
+
+}  // namespace
+}  // namespace detail
+
+chrome_trace_sink_mt::chrome_trace_sink_mt(std::string const& filename)
+  : sink{std::make_unique<detail::sink_impl>(
+      std::make_shared<detail::chrome_trace_sink<std::mutex>>(filename))}
+{
+}
+
+}  // namespace rapids_logger
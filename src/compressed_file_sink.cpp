@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/filename.hpp"
+#include "detail/sink_impl.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#ifdef RAPIDS_LOGGER_HAS_ZLIB
+#include <zlib.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif
+
+namespace rapids_logger {
+
+#ifdef RAPIDS_LOGGER_HAS_ZLIB
+namespace detail {
+namespace {
+
+// Formatted records are accumulated until a batch of this size is ready to be compressed.
+constexpr std::size_t batch_size = 1 << 20;
+
+// Size of the chunks of compressed output written to the file.
+constexpr std::size_t output_chunk_size = 1 << 18;
+
+/**
+ * @brief A sink that writes a gzip stream to a file.
+ *
+ * Callers only append formatted records to an in-memory batch. Full batches are handed to a
+ * dedicated thread that compresses and writes them while callers fill the next batch, so callers
+ * only ever wait if the compressor falls a full batch behind. A flush compresses everything
+ * logged so far and ends it with a sync point, so the file can be decompressed up to that point
+ * even if the process dies before the stream is finished.
+ */
+template <class Mutex>
+class compressed_file_sink : public formatting_sink<Mutex> {
+ public:
+  compressed_file_sink(std::string const& filename, bool truncate, int compression_level)
+    : filename_{filename}, file_{std::fopen(filename.c_str(), truncate ? "wb" : "ab")}
+  {
+    if (file_ == nullptr) {
+      throw std::runtime_error("Failed opening file " + filename + " for writing");
+    }
+    // A window size of 15 + 16 selects the gzip wrapper. When appending, the new stream becomes
+    // a further gzip member, which gzip-compatible readers decompress as a continuation.
+    if (deflateInit2(
+          &stream_, compression_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      std::fclose(file_);
+      throw std::runtime_error("Failed initializing zlib for " + filename);
+    }
+    pending_.reserve(batch_size);
+    in_flight_.reserve(batch_size);
+    output_.resize(output_chunk_size);
+    compressor_ = std::thread{[this] { compress_batches(); }};
+  }
+
+  ~compressed_file_sink() override
+  {
+    {
+      std::lock_guard<Mutex> sink_lock(spdlog::sinks::base_sink<Mutex>::mutex_);
+      submit(Z_FINISH);
+    }
+    {
+      std::unique_lock lock{state_mutex_};
+      idle_.wait(lock, [this] { return !busy_; });
+      stop_ = true;
+    }
+    work_.notify_one();
+    compressor_.join();
+    deflateEnd(&stream_);
+    std::fclose(file_);
+  }
+
+  compressed_file_sink(compressed_file_sink const&)            = delete;
+  compressed_file_sink& operator=(compressed_file_sink const&) = delete;
+
+ protected:
+  bool write_(const spdlog::details::log_msg&, spdlog::memory_buf_t& formatted) override
+  {
+    pending_.insert(pending_.end(), formatted.data(), formatted.data() + formatted.size());
+    if (pending_.size() >= batch_size) { submit(Z_NO_FLUSH); }
+    return true;
+  }
+
+  void flush_() override
+  {
+    submit(Z_SYNC_FLUSH);
+    std::unique_lock lock{state_mutex_};
+    idle_.wait(lock, [this] { return !busy_; });
+    report_error(lock);
+  }
+
+ private:
+  /**
+   * @brief Hand the pending batch to the compressor thread.
+   *
+   * Must be called with the sink's mutex held. An error in compressing or writing an earlier
+   * batch is thrown once the batch has been handed over.
+   *
+   * @param flush_mode The zlib flush mode to compress the batch with
+   */
+  void submit(int flush_mode)
+  {
+    std::unique_lock lock{state_mutex_};
+    idle_.wait(lock, [this] { return !busy_; });
+    std::swap(pending_, in_flight_);
+    flush_mode_ = flush_mode;
+    busy_       = true;
+    work_.notify_one();
+    report_error(lock);
+  }
+
+  /**
+   * @brief Throw the error the compressor thread ran into, if any.
+   *
+   * The logger reports it through its error handler.
+   */
+  void report_error(std::unique_lock<std::mutex>& lock)
+  {
+    if (error_.empty()) { return; }
+    std::string error;
+    std::swap(error, error_);
+    lock.unlock();
+    throw std::runtime_error(error);
+  }
+
+  void compress_batches()
+  {
+    std::unique_lock lock{state_mutex_};
+    while (true) {
+      work_.wait(lock, [this] { return busy_ || stop_; });
+      if (!busy_) { return; }
+      lock.unlock();
+      auto error = compress(in_flight_, flush_mode_);
+      in_flight_.clear();
+      lock.lock();
+      if (!error.empty() && error_.empty()) { error_ = std::move(error); }
+      busy_ = false;
+      idle_.notify_all();
+    }
+  }
+
+  /**
+   * @brief Compress a batch and write it to the file.
+   *
+   * @return A description of the error if the batch could not be compressed or written
+   */
+  std::string compress(std::vector<char>& input, int flush_mode)
+  {
+    stream_.next_in  = reinterpret_cast<Bytef*>(input.data());
+    stream_.avail_in = static_cast<uInt>(input.size());
+    do {
+      stream_.next_out  = reinterpret_cast<Bytef*>(output_.data());
+      stream_.avail_out = static_cast<uInt>(output_.size());
+      // Z_BUF_ERROR only means that no progress was possible, which ends the loop below.
+      if (auto const result = deflate(&stream_, flush_mode);
+          result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        return "Failed compressing records for file " + filename_ + ": " +
+               (stream_.msg != nullptr ? stream_.msg : std::to_string(result));
+      }
+      auto const produced = output_.size() - stream_.avail_out;
+      if (produced > 0 && std::fwrite(output_.data(), 1, produced, file_) != produced) {
+        return "Failed writing to file " + filename_ + ": " + std::strerror(errno);
+      }
+    } while (stream_.avail_out == 0);
+    if (flush_mode != Z_NO_FLUSH && std::fflush(file_) != 0) {
+      return "Failed writing to file " + filename_ + ": " + std::strerror(errno);
+    }
+    return {};
+  }
+
+  std::string filename_;
+  std::FILE* file_;
+  z_stream stream_{};
+  std::vector<char> pending_;    ///< The batch being filled by callers
+  std::vector<char> in_flight_;  ///< The batch being compressed
+  std::vector<char> output_;     ///< Compressed output staging buffer
+  int flush_mode_{Z_NO_FLUSH};
+
+  std::mutex state_mutex_;
+  std::condition_variable work_;
+  std::condition_variable idle_;
+  bool busy_{false};
+  bool stop_{false};
+  std::string error_;  ///< An error of the compressor not yet reported to a logging thread
+  std::thread compressor_;
+};
+
+}  // namespace
+}  // namespace detail
+#endif
+
+namespace {
+
+std::unique_ptr<detail::sink_impl> make_compressed_file_sink(
+  [[maybe_unused]] std::string const& filename,
+  [[maybe_unused]] bool truncate,
+  [[maybe_unused]] int compression_level)
+{
+#ifdef RAPIDS_LOGGER_HAS_ZLIB
+  return std::make_unique<detail::sink_impl>(
+    std::make_shared<detail::compressed_file_sink<std::mutex>>(
+      detail::expand_filename(filename), truncate, compression_level));
+#else
+  throw std::runtime_error("rapids_logger was built without zlib, compressed sinks are unavailable");
+#endif
+}
+
+}  // namespace
+
+compressed_file_sink_mt::compressed_file_sink_mt(std::string const& filename,
+                                                 bool truncate,
+                                                 int compression_level)
+  : sink{make_compressed_file_sink(filename, truncate, compression_level)}
+{
+}
+
+}  // namespace rapids_logger
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/context.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+
+namespace rapids_logger {
+namespace detail {
+
+bool thread_context::push(std::string_view key, std::string_view value) noexcept
+{
+  std::size_t const separator = (size > 0) ? 1 : 0;
+  auto const needed    = separator + key.size() + 1 + value.size();
+  if (n_fields == max_fields || size + needed > capacity) { return false; }
+  auto* out = text + size;
+  if (separator != 0) { *out++ = ' '; }
+  out    = std::copy(key.begin(), key.end(), out);
+  *out++ = ':';
+  std::copy(value.begin(), value.end(), out);
+  size += needed;
+  ends[n_fields++] = size;
+  return true;
+}
+
+void thread_context::pop() noexcept
+{
+  --n_fields;
+  size = (n_fields > 0) ? ends[n_fields - 1] : 0;
+}
+
+void thread_context::assign(std::string_view rendered) noexcept
+{
+  size     = std::min(rendered.size(), capacity);
+  n_fields = 0;
+  std::copy_n(rendered.data(), size, text);
+}
+
+thread_context& current_context() noexcept
+{
+  thread_local thread_context context;
+  return context;
+}
+
+}  // namespace detail
+
+context_scope::context_scope(std::string_view key, std::string_view value)
+  : pushed_{detail::current_context().push(key, value)}
+{
+}
+
+context_scope::context_scope(std::string_view key, std::int64_t value)
+{
+  char digits[20];  // Enough for any int64_t, including the sign
+  auto const end = std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+  std::string_view const text{digits, static_cast<std::size_t>(end - digits)};
+  pushed_ = detail::current_context().push(key, text);
+}
+
+context_scope::~context_scope()
+{
+  if (pushed_) { detail::current_context().pop(); }
+}
+
+}  // namespace rapids_logger
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/crash_flush.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+// The registry is a fixed array so that the signal handler can walk it without locking.
+constexpr std::size_t max_crash_flushables = 64;
+
+std::array<std::atomic<crash_flushable*>, max_crash_flushables> crash_flushables{};
+
+constexpr std::array<int, 3> fatal_signals{SIGSEGV, SIGABRT, SIGBUS};
+
+// The dispositions replaced by the crash handler, restored before re-raising.
+std::array<struct sigaction, fatal_signals.size()> previous_actions{};
+
+std::atomic<bool> handler_installed{false};
+
+// The progress of the flush done by the first crashing thread.
+constexpr int not_crashing = 0;
+constexpr int flushing     = 1;
+constexpr int flushed      = 2;
+std::atomic<int> crash_state{not_crashing};
+std::atomic<pid_t> flushing_thread{0};
+
+pid_t current_thread() noexcept { return static_cast<pid_t>(::syscall(SYS_gettid)); }
+
+void crash_handler(int sig, siginfo_t*, void*)
+{
+  // Only the first crashing thread flushes. Other threads that crash meanwhile wait for it rather
+  // than ending the process in the middle of the flush, while a crash in the flush itself ends
+  // the process at once.
+  auto const self = current_thread();
+  int expected{not_crashing};
+  if (crash_state.compare_exchange_strong(expected, flushing, std::memory_order_acq_rel)) {
+    flushing_thread.store(self, std::memory_order_release);
+    for (auto& slot : crash_flushables) {
+      if (auto* target = slot.load(std::memory_order_acquire)) { target->emergency_flush(); }
+    }
+    crash_state.store(flushed, std::memory_order_release);
+  } else if (flushing_thread.load(std::memory_order_acquire) != self) {
+    while (crash_state.load(std::memory_order_acquire) != flushed) {
+      timespec const delay{0, 1000000};
+      ::nanosleep(&delay, nullptr);
+    }
+  }
+  for (std::size_t i = 0; i < fatal_signals.size(); ++i) {
+    if (fatal_signals[i] == sig) { ::sigaction(sig, &previous_actions[i], nullptr); }
+  }
+  // The signal is blocked until this handler returns, and is then delivered to the previous
+  // handler (by default, terminating the process).
+  ::raise(sig);
+}
+
+/**
+ * @brief An alternate signal stack for the crash handler, owned by one thread.
+ */
+class crash_stack {
+ public:
+  crash_stack()
+  {
+    // A stack installed by the application is left alone.
+    stack_t current{};
+    if (::sigaltstack(nullptr, &current) != 0 || (current.ss_flags & SS_DISABLE) == 0) { return; }
+    auto const size = std::max<std::size_t>(SIGSTKSZ, 1 << 16);
+    memory_         = std::malloc(size);
+    if (memory_ == nullptr) { return; }
+    stack_t stack{};
+    stack.ss_sp   = memory_;
+    stack.ss_size = size;
+    if (::sigaltstack(&stack, nullptr) != 0) {
+      std::free(memory_);
+      memory_ = nullptr;
+    }
+  }
+  ~crash_stack()
+  {
+    if (memory_ == nullptr) { return; }
+    stack_t disable{};
+    disable.ss_flags = SS_DISABLE;
+    ::sigaltstack(&disable, nullptr);
+    std::free(memory_);
+  }
+
+  crash_stack(crash_stack const&)            = delete;
+  crash_stack& operator=(crash_stack const&) = delete;
+
+ private:
+  void* memory_{nullptr};
+};
+
+}  // namespace
+
+void prepare_crash_stack() noexcept
+{
+  if (!handler_installed.load(std::memory_order_relaxed)) { return; }
+  thread_local crash_stack stack;
+}
+
+bool register_crash_flushable(crash_flushable* target) noexcept
+{
+  for (auto& slot : crash_flushables) {
+    crash_flushable* expected{nullptr};
+    if (slot.compare_exchange_strong(expected, target, std::memory_order_release)) { return true; }
+  }
+  return false;
+}
+
+void unregister_crash_flushable(crash_flushable* target) noexcept
+{
+  for (auto& slot : crash_flushables) {
+    crash_flushable* expected{target};
+    if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_release)) { return; }
+  }
+}
+
+}  // namespace detail
+
+void install_crash_handler()
+{
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    struct sigaction action {};
+    action.sa_sigaction = detail::crash_handler;
+    action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i < detail::fatal_signals.size(); ++i) {
+      ::sigaction(detail::fatal_signals[i], &action, &detail::previous_actions[i]);
+    }
+    detail::handler_installed.store(true, std::memory_order_relaxed);
+  });
+  detail::prepare_crash_stack();
+}
+
+}  // namespace rapids_logger
@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+// TODO: Check if the below issue persists
+// This issue claims to have been resolved in gcc 8, but we still seem to encounter it here.
+// The code compiles and links and all tests pass, and nm shows symbols resolved as expected.
+// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=80947
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+
+#include <spdlog/details/fmt_helper.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+#pragma GCC diagnostic pop
+
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief The diagnostic context fields of one thread, rendered as `key:value` pairs.
+ *
+ * Fields are pushed and popped in stack order by context_scope. The storage is inline and of
+ * fixed size, so changing the context never allocates; fields that do not fit are omitted.
+ */
+struct thread_context {
+  static constexpr std::size_t capacity   = 256;  ///< Bytes of rendered fields
+  static constexpr std::size_t max_fields = 8;    ///< Fields that can be set at once
+
+  char text[capacity];
+  std::size_t size{0};
+  std::size_t ends[max_fields];  ///< The end of each field in text, for popping
+  std::size_t n_fields{0};
+
+  std::string_view view() const noexcept { return {text, size}; }
+
+  /**
+   * @brief Append a field.
+   *
+   * @return false if the field did not fit and was omitted
+   */
+  bool push(std::string_view key, std::string_view value) noexcept;
+
+  /**
+   * @brief Remove the most recently pushed field.
+   */
+  void pop() noexcept;
+
+  /**
+   * @brief Replace the fields with the rendered fields of another thread.
+   *
+   * Used by writer threads to format records with the context of the thread that logged them.
+   * The replaced fields cannot be popped.
+   */
+  void assign(std::string_view rendered) noexcept;
+};
+
+/**
+ * @brief Get the calling thread's context.
+ */
+thread_context& current_context() noexcept;
+
+/**
+ * @brief The pattern flag that renders the calling thread's context fields.
+ */
+constexpr char context_flag = '&';
+
+/**
+ * @brief Formats the context of the thread formatting the record.
+ *
+ * Records are formatted on the thread that logs them, so this is the context that was in scope
+ * when the record was logged.
+ */
+class context_formatter : public spdlog::custom_flag_formatter {
+ public:
+  void format(const spdlog::details::log_msg&, const std::tm&, spdlog::memory_buf_t& dest) override
+  {
+    auto const text = current_context().view();
+    spdlog::details::fmt_helper::append_string_view({text.data(), text.size()}, dest);
+  }
+
+  std::unique_ptr<spdlog::custom_flag_formatter> clone() const override
+  {
+    return std::make_unique<context_formatter>();
+  }
+};
+
+/**
+ * @brief Make a formatter for a pattern, with support for the context flag.
+ */
+inline std::unique_ptr<spdlog::pattern_formatter> make_formatter(std::string pattern)
+{
+  auto formatter = std::make_unique<spdlog::pattern_formatter>();
+  formatter->add_flag<context_formatter>(context_flag).set_pattern(std::move(pattern));
+  return formatter;
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
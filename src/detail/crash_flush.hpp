@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief Interface for objects that hold records that can be written out while crashing.
+ *
+ * Sinks that buffer records in memory implement this so that the crash handler can write the
+ * buffered records to their file descriptors before the process dies.
+ */
+class crash_flushable {
+ public:
+  virtual ~crash_flushable() = default;
+
+  /**
+   * @brief Write out any buffered records.
+   *
+   * Called from a fatal signal handler, possibly while another thread (or the interrupted code
+   * on this thread) is in the middle of logging. Implementations must only use async-signal-safe
+   * operations: no locks, no allocation, and no stdio. Writing a partially updated buffer is
+   * acceptable, since the alternative is losing it.
+   */
+  virtual void emergency_flush() noexcept = 0;
+
+  /**
+   * @brief Write text that the object never buffered, such as records still queued for a writer
+   * thread, after its buffered records.
+   *
+   * Called from a fatal signal handler, with the same restrictions as emergency_flush(). Objects
+   * that cannot write text ignore it.
+   */
+  virtual void emergency_write(char const*, std::size_t) noexcept {}
+};
+
+/**
+ * @brief Register an object to be flushed by the crash handler.
+ *
+ * @return false if the registry is full
+ */
+bool register_crash_flushable(crash_flushable* target) noexcept;
+
+/**
+ * @brief Stop flushing an object from the crash handler.
+ */
+void unregister_crash_flushable(crash_flushable* target) noexcept;
+
+/**
+ * @brief Give the calling thread an alternate signal stack, once the crash handler is installed.
+ *
+ * Without one, the crash handler cannot run on a thread that crashed by overflowing its stack.
+ * Threads that already have an alternate stack keep it.
+ */
+void prepare_crash_stack() noexcept;
+
+/**
+ * @brief Write a whole buffer to a file descriptor using only async-signal-safe calls.
+ *
+ * @return false if the write failed
+ */
+inline bool write_all(int fd, char const* data, std::size_t size) noexcept
+{
+  while (size > 0) {
+    auto const n = ::write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) { continue; }
+      return false;
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
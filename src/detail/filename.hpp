@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief Get the rank of this process in a multi-process job.
+ *
+ * The rank is read from the first of RAPIDS_LOGGER_RANK, OMPI_COMM_WORLD_RANK, PMI_RANK and
+ * SLURM_PROCID that is set, and is "0" if none of them is.
+ */
+std::string process_rank();
+
+/**
+ * @brief Substitute the per-process placeholders in a file name.
+ *
+ * `{pid}` is replaced by the process id, `{hostname}` by the host name, and `{rank}` by
+ * process_rank(). Other text, including unknown placeholders, is kept as is.
+ *
+ * @param filename The file name, possibly containing placeholders
+ * @return The file name for this process
+ */
+std::string expand_filename(std::string const& filename);
+
+}  // namespace detail
+}  // namespace rapids_logger
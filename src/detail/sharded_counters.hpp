@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief Get the shard used by the calling thread.
+ *
+ * Threads are assigned shards round-robin on first use so that concurrently logging threads
+ * update different cache lines.
+ */
+inline std::size_t thread_shard(std::size_t n_shards)
+{
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local std::size_t const shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shard % n_shards;
+}
+
+/**
+ * @brief A fixed set of counters that can be incremented from many threads without contention.
+ *
+ * Every thread increments its own cache-line aligned copy of the counters. Reads sum across all
+ * copies, so they are more expensive than writes, which is the right trade-off for metrics that
+ * are updated on every record and scraped periodically.
+ *
+ * @tparam N The number of counters
+ */
+template <std::size_t N>
+class sharded_counters {
+ public:
+  /**
+   * @brief Add to a counter.
+   *
+   * @param counter The index of the counter
+   * @param value The amount to add
+   */
+  void add(std::size_t counter, std::uint64_t value = 1) noexcept
+  {
+    shards_[thread_shard(n_shards)].values[counter].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sum every counter across all shards.
+   */
+  std::array<std::uint64_t, N> sum() const noexcept
+  {
+    std::array<std::uint64_t, N> totals{};
+    for (auto const& shard : shards_) {
+      for (std::size_t i = 0; i < N; ++i) {
+        totals[i] += shard.values[i].load(std::memory_order_relaxed);
+      }
+    }
+    return totals;
+  }
+
+ private:
+  static constexpr std::size_t n_shards = 16;
+
+  struct alignas(64) shard {
+    std::array<std::atomic<std::uint64_t>, N> values{};
+  };
+  std::array<shard, n_shards> shards_{};
+};
+
+}  // namespace detail
+}  // namespace rapids_logger
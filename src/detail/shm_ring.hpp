@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+// The layout of the shared-memory rings written by shm_ring_sink_mt and drained by
+// rapids_logger_collector. Both sides include this header, so any change to the layout must bump
+// the version.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace rapids_logger {
+namespace detail {
+namespace shm_ring {
+
+constexpr std::uint64_t magic   = 0x474E'4952'474F'4C52;  // "RLOGRING"
+constexpr std::uint32_t version = 1;
+
+// Records are aligned so that a record header always fits in the space left before wrapping.
+constexpr std::size_t record_alignment = 16;
+
+// Size marking a record header that pads out the end of the ring.
+constexpr std::uint32_t padding = UINT32_MAX;
+
+/**
+ * @brief The control block at the start of every ring.
+ *
+ * The producer and the collector only ever write to their own position, so the ring is lock
+ * free; the positions are on separate cache lines to avoid false sharing.
+ */
+struct header {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t reserved;
+  std::uint64_t capacity;  ///< Size of the data region in bytes, a power of two
+  std::int64_t pid;        ///< The producing process
+  alignas(64) std::atomic<std::uint64_t> write_pos;  ///< Total bytes published by the producer
+  alignas(64) std::atomic<std::uint64_t> read_pos;   ///< Total bytes consumed by the collector
+  alignas(64) std::atomic<std::uint64_t> dropped;    ///< Records dropped because the ring was full
+  std::atomic<std::uint32_t> closed;                 ///< Set once the producer will not write again
+};
+
+/**
+ * @brief The header preceding each record's formatted text.
+ */
+struct record_header {
+  std::uint32_t size;          ///< Size of the text in bytes, or `padding`
+  std::int32_t level;          ///< The record's level
+  std::int64_t timestamp_ns;   ///< The record's time in nanoseconds since the epoch
+};
+static_assert(sizeof(record_header) == record_alignment);
+
+/**
+ * @brief Offset of the data region from the start of the mapping.
+ */
+constexpr std::size_t data_offset = 4096;
+static_assert(sizeof(header) <= data_offset);
+
+/**
+ * @brief Get the number of ring bytes used by a record with the given text size.
+ */
+constexpr std::size_t record_bytes(std::size_t text_size)
+{
+  return (sizeof(record_header) + text_size + record_alignment - 1) & ~(record_alignment - 1);
+}
+
+/**
+ * @brief Get the shm_open name of the ring written by a process.
+ *
+ * @param name The name shared by all rings that are collected together
+ * @param pid The producing process
+ */
+inline std::string object_name(std::string const& name, long pid)
+{
+  return "/" + name + "." + std::to_string(pid);
+}
+
+/**
+ * @brief A view of a mapped ring.
+ */
+class ring {
+ public:
+  explicit ring(void* mapping)
+    : header_{static_cast<header*>(mapping)},
+      data_{static_cast<char*>(mapping) + data_offset},
+      mask_{header_->capacity - 1}
+  {
+  }
+
+  header& control() const noexcept { return *header_; }
+
+  /**
+   * @brief Publish a record, or count it as dropped if the ring does not have room for it.
+   *
+   * Must only be called by one thread at a time. Never blocks and makes no syscalls.
+   *
+   * @return true if the record was published
+   */
+  bool try_write(std::int32_t level, std::int64_t timestamp_ns, char const* text, std::size_t size)
+  {
+    auto const capacity = header_->capacity;
+    auto const needed   = record_bytes(size);
+    auto write          = header_->write_pos.load(std::memory_order_relaxed);
+    auto const read     = header_->read_pos.load(std::memory_order_acquire);
+    auto offset         = write & mask_;
+    auto const tail     = capacity - offset;
+    auto const wraps    = tail < needed;
+    if (size >= padding || capacity - (write - read) < needed + (wraps ? tail : 0)) {
+      header_->dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (wraps) {
+      record_header const pad{padding, 0, 0};
+      std::memcpy(data_ + offset, &pad, sizeof(pad));
+      write += tail;
+      offset = 0;
+    }
+    record_header const record{static_cast<std::uint32_t>(size), level, timestamp_ns};
+    std::memcpy(data_ + offset, &record, sizeof(record));
+    std::memcpy(data_ + offset + sizeof(record), text, size);
+    header_->write_pos.store(write + needed, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Look at the oldest unconsumed record without consuming it.
+   *
+   * @param[out] record The record's header
+   * @param[out] text The record's text, valid until the record is consumed
+   * @return true if a record was available
+   */
+  bool peek(record_header& record, char const*& text)
+  {
+    auto read        = header_->read_pos.load(std::memory_order_relaxed);
+    auto const write = header_->write_pos.load(std::memory_order_acquire);
+    while (read != write) {
+      auto const offset = read & mask_;
+      std::memcpy(&record, data_ + offset, sizeof(record));
+      if (record.size != padding) {
+        text = data_ + offset + sizeof(record);
+        return true;
+      }
+      read += header_->capacity - offset;
+      header_->read_pos.store(read, std::memory_order_release);
+    }
+    return false;
+  }
+
+  /**
+   * @brief Consume the record returned by the last successful peek.
+   */
+  void consume(record_header const& record)
+  {
+    auto const read = header_->read_pos.load(std::memory_order_relaxed);
+    header_->read_pos.store(read + record_bytes(record.size), std::memory_order_release);
+  }
+
+ private:
+  header* header_;
+  char* data_;
+  std::uint64_t mask_;
+};
+
+}  // namespace shm_ring
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,318 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "crash_flush.hpp"
+#include "sharded_counters.hpp"
+#include "spans.hpp"
+#include "tsc_clock.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+// TODO: Check if the below issue persists
+// This issue claims to have been resolved in gcc 8, but we still seem to encounter it here.
+// The code compiles and links and all tests pass, and nm shows symbols resolved as expected.
+// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=80947
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/sink.h>
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief Interface for sinks that keep their own output statistics.
+ */
+class output_statistics {
+ public:
+  virtual ~output_statistics() = default;
+
+  /**
+   * @brief Get the number of bytes written after formatting.
+   */
+  virtual std::uint64_t bytes_written() const noexcept = 0;
+
+  /**
+   * @brief Get the number of records written.
+   */
+  virtual std::uint64_t records_written() const noexcept = 0;
+
+  /**
+   * @brief Get the number of records discarded instead of written.
+   */
+  virtual std::uint64_t dropped() const noexcept { return 0; }
+};
+
+/**
+ * @brief Interface for sinks that can write a record that was already formatted by the logger.
+ *
+ * When several such sinks are attached to a logger, the logger formats each record once and
+ * hands the same buffer to all of them.
+ */
+class formatted_writer {
+ public:
+  virtual ~formatted_writer() = default;
+
+  /**
+   * @brief Write a record formatted with the logger's pattern.
+   *
+   * @param msg The record
+   * @param formatted The formatted record
+   */
+  virtual void log_formatted(const spdlog::details::log_msg& msg,
+                             spdlog::memory_buf_t& formatted) = 0;
+};
+
+/**
+ * @brief Base class for the sinks that write formatted records.
+ *
+ * spdlog's own sinks format every record into a fresh buffer, which allocates for all but the
+ * shortest messages when spdlog is built on std::format. This base instead reuses one buffer per
+ * sink (access is serialized by the sink's mutex), so that once the buffer has grown to fit the
+ * messages being logged, writing a record does not allocate. Records that were already formatted
+ * by the logger are written without formatting them again.
+ */
+template <class Mutex>
+class formatting_sink : public spdlog::sinks::base_sink<Mutex>,
+                        public formatted_writer,
+                        public output_statistics {
+ public:
+  void log_formatted(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) override
+  {
+    std::lock_guard<Mutex> lock(spdlog::sinks::base_sink<Mutex>::mutex_);
+    if (write_(msg, formatted)) { count_written(formatted.size()); }
+  }
+
+  std::uint64_t bytes_written() const noexcept override
+  {
+    return bytes_written_.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t records_written() const noexcept override
+  {
+    return records_written_.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    formatted_.clear();
+    spdlog::sinks::base_sink<Mutex>::formatter_->format(msg, formatted_);
+    if (write_(msg, formatted_)) { count_written(formatted_.size()); }
+  }
+
+  /**
+   * @brief Write a formatted record.
+   *
+   * The buffer may be shared with other sinks, so implementations may only modify it
+   * temporarily and must restore its contents before returning.
+   *
+   * @param msg The record
+   * @param formatted The formatted record
+   * @return false if the sink dropped the record instead of writing it
+   */
+  virtual bool write_(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) = 0;
+
+ private:
+  void count_written(std::size_t bytes) noexcept
+  {
+    bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+    records_written_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  spdlog::memory_buf_t formatted_;
+  std::atomic<std::uint64_t> bytes_written_{0};
+  std::atomic<std::uint64_t> records_written_{0};
+};
+
+/**
+ * @brief A sink decorator that records how much work the decorated sink does.
+ *
+ * Every sink handed out through the public API is wrapped in one of these, so metrics are
+ * available for all sinks without each implementation having to track them.
+ */
+class instrumented_sink : public spdlog::sinks::sink {
+ public:
+  explicit instrumented_sink(std::shared_ptr<spdlog::sinks::sink> sink)
+    : inner_{std::move(sink)},
+      writer_{dynamic_cast<formatted_writer*>(inner_.get())},
+      statistics_{dynamic_cast<output_statistics*>(inner_.get())},
+      crash_flushable_{dynamic_cast<crash_flushable*>(inner_.get())},
+      span_writer_{dynamic_cast<span_writer*>(inner_.get())}
+  {
+  }
+
+  void log(const spdlog::details::log_msg& msg) override
+  {
+    timed([&] { inner_->log(msg); });
+  }
+
+  /**
+   * @brief Whether the decorated sink can write records formatted by the logger.
+   */
+  bool accepts_formatted() const noexcept { return writer_ != nullptr; }
+
+  /**
+   * @brief Write a record formatted by the logger.
+   *
+   * May only be called if accepts_formatted() is true.
+   */
+  void log_formatted(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted)
+  {
+    timed([&] { writer_->log_formatted(msg, formatted); });
+  }
+
+  /**
+   * @brief Write spans, if the decorated sink writes spans.
+   */
+  void write_spans(std::string_view logger_name, std::vector<span_event> const& events)
+  {
+    if (span_writer_ != nullptr) { span_writer_->write_spans(logger_name, events); }
+  }
+
+  void flush() override
+  {
+    inner_->flush();
+    counters_.add(flushes);
+  }
+
+  /**
+   * @brief Get the decorated sink's interface for the crash handler, if it buffers records.
+   */
+  crash_flushable* crash_target() const noexcept { return crash_flushable_; }
+
+  void set_pattern(const std::string& pattern) override { inner_->set_pattern(pattern); }
+
+  void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+  {
+    inner_->set_formatter(std::move(sink_formatter));
+  }
+
+  /**
+   * @brief Get a snapshot of the sink's metrics.
+   */
+  sink_metrics metrics() const
+  {
+    auto const totals = counters_.sum();
+    sink_metrics result{};
+    result.messages = totals[messages];
+    result.flushes  = totals[flushes];
+    // Sinks that keep their own statistics do not count the records they drop as written.
+    if (statistics_ != nullptr) {
+      result.messages = statistics_->records_written();
+      result.bytes    = statistics_->bytes_written();
+      result.drops    = statistics_->dropped();
+    }
+    std::copy(totals.begin() + latency, totals.end(), result.latency_histogram.begin());
+    return result;
+  }
+
+  /**
+   * @brief Get the decorated sink.
+   */
+  spdlog::sinks::sink& inner() const noexcept { return *inner_; }
+
+ private:
+  template <typename F>
+  void timed(F&& write)
+  {
+    // Every record is timed, so the counter is used where possible: it is much cheaper to read
+    // than the steady clock on hosts with a slow clocksource.
+    std::int64_t elapsed{0};
+    auto& clock = timing_clock();
+    if (clock.available()) {
+      auto const start = tsc_clock::ticks();
+      write();
+      auto const end = tsc_clock::ticks();
+      // The counters of different cores may disagree slightly if the thread migrates.
+      if (end > start) { elapsed = clock.to_nanoseconds(end - start); }
+    } else {
+      auto const start = std::chrono::steady_clock::now();
+      write();
+      elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+    }
+    counters_.add(messages);
+    counters_.add(latency + latency_bucket(elapsed));
+  }
+
+  /**
+   * @brief Get the clock used to time writes.
+   *
+   * The clock is looked up on the first timed write rather than on construction, so that creating
+   * a sink does not pay for the clock's calibration.
+   */
+  tsc_clock& timing_clock()
+  {
+    auto* clock = clock_.load(std::memory_order_acquire);
+    if (clock == nullptr) {
+      clock = &tsc_clock::instance();
+      clock_.store(clock, std::memory_order_release);
+    }
+    return *clock;
+  }
+
+  static std::size_t latency_bucket(std::int64_t ns)
+  {
+    if (ns <= 0) { return 0; }
+    return std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(ns)),
+                                 sink_metrics::latency_buckets - 1);
+  }
+
+  // Counter indices
+  static constexpr std::size_t messages = 0;
+  static constexpr std::size_t flushes  = 1;
+  static constexpr std::size_t latency  = 2;
+
+  std::shared_ptr<spdlog::sinks::sink> inner_;
+  formatted_writer* writer_;
+  output_statistics* statistics_;
+  crash_flushable* crash_flushable_;
+  span_writer* span_writer_;
+  std::atomic<tsc_clock*> clock_{nullptr};  ///< Set on the first timed write
+  sharded_counters<latency + sink_metrics::latency_buckets> counters_;
+};
+
+/**
+ * @brief The sink_impl class is a wrapper around an spdlog sink.
+ *
+ * This class is the impl part of the PImpl for the sink.
+ */
+class sink_impl {
+ public:
+  sink_impl(std::shared_ptr<spdlog::sinks::sink> sink)
+    : underlying{std::make_shared<instrumented_sink>(std::move(sink))}
+  {
+  }
+
+ private:
+  std::shared_ptr<instrumented_sink> underlying;
+  // The sink_vector needs to be able to pass the underlying sink to the spdlog logger.
+  friend class logger::sink_vector;
+  // The sink needs to be able to collect the metrics of the underlying sink.
+  friend class rapids_logger::sink;
+  // The stall guard needs to be able to write to the sink it decorates.
+  friend class rapids_logger::stall_guard_sink_mt;
+};
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <rapids_logger/logger.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief A completed span_scope.
+ */
+struct span_event {
+  char const* name;
+  level_enum level;
+  std::uint64_t start;    ///< Raw timestamp from span_ticks()
+  std::uint64_t end;      ///< Raw timestamp from span_ticks()
+  std::size_t thread_id;  ///< The same thread id as in the thread's log records
+};
+
+/**
+ * @brief Interface for sinks that write spans.
+ */
+class span_writer {
+ public:
+  virtual ~span_writer() = default;
+
+  /**
+   * @brief Write spans recorded for a logger.
+   *
+   * @param logger_name The name of the logger the spans were recorded for
+   * @param events The spans
+   */
+  virtual void write_spans(std::string_view logger_name,
+                           std::vector<span_event> const& events) = 0;
+};
+
+/**
+ * @brief Read the clock used to time spans.
+ *
+ * This is the CPU timestamp counter where it is usable (see tsc_clock), so timing a span costs two
+ * counter reads; the conversion to wall time is deferred until the span is written.
+ */
+std::uint64_t span_ticks() noexcept;
+
+/**
+ * @brief Convert a value returned by span_ticks() to wall time.
+ */
+std::chrono::system_clock::time_point span_time(std::uint64_t ticks) noexcept;
+
+/**
+ * @brief Get a process-wide unique identifier for a logger's spans.
+ *
+ * Identifiers are never reused, so that spans cannot be attributed to a logger that was created
+ * at the address of a destroyed one.
+ */
+std::uint64_t new_span_owner() noexcept;
+
+/**
+ * @brief Record a completed span in the calling thread's buffer for the owner.
+ *
+ * Each thread has a fixed-size buffer per owner that only it writes to, so recording neither
+ * locks nor allocates once the buffer exists. Spans that do not fit are counted and dropped.
+ */
+void record_span(std::uint64_t owner,
+                 char const* name,
+                 level_enum level,
+                 std::uint64_t start,
+                 std::uint64_t end) noexcept;
+
+/**
+ * @brief Take the spans recorded for the owner by all threads.
+ *
+ * @param owner The owner of the spans
+ * @param events The vector to append the spans to
+ * @return The number of spans dropped since the last collection
+ */
+std::uint64_t collect_spans(std::uint64_t owner, std::vector<span_event>& events);
+
+/**
+ * @brief Discard the owner's buffers, once the owner is destroyed.
+ */
+void release_spans(std::uint64_t owner) noexcept;
+
+}  // namespace detail
+}  // namespace rapids_logger
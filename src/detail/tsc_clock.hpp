@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief A wall clock driven by the CPU timestamp counter.
+ *
+ * Reading the counter is a single instruction, whereas system_clock::now() may fall back to a
+ * syscall on hosts with a slow clocksource. Counter ticks are converted to wall time using a
+ * calibration against the system clock that is taken on first use and refreshed lazily (at most
+ * once per refresh interval) by whichever thread first notices that it is due. Readers never
+ * block on a refresh; the calibration is published through a seqlock.
+ *
+ * On hosts without a constant-rate counter the clock transparently falls back to the system
+ * clock.
+ */
+class tsc_clock {
+ public:
+  using time_point = std::chrono::system_clock::time_point;
+
+  /**
+   * @brief Get the process-wide clock, calibrating it on first use.
+   */
+  static tsc_clock& instance();
+
+  /**
+   * @brief Whether a constant-rate counter is available on this host.
+   */
+  bool available() const noexcept { return available_; }
+
+  /**
+   * @brief Read the raw counter.
+   *
+   * This is the only work that needs to happen on a hot path; the result may be converted to
+   * wall time later (and on a different thread) with to_time_point.
+   */
+  static std::uint64_t ticks() noexcept;
+
+  /**
+   * @brief Convert a raw counter value to wall time.
+   *
+   * @param ticks A value previously returned by ticks()
+   * @return The corresponding system_clock time
+   */
+  time_point to_time_point(std::uint64_t ticks) noexcept;
+
+  /**
+   * @brief Convert a number of elapsed counter ticks to nanoseconds.
+   *
+   * May only be used if the clock is available.
+   *
+   * @param ticks The difference between two values returned by ticks()
+   * @return The elapsed time in nanoseconds
+   */
+  std::int64_t to_nanoseconds(std::uint64_t ticks) const noexcept
+  {
+    return static_cast<std::int64_t>(static_cast<double>(ticks) *
+                                     ns_per_tick_.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Get the current wall time.
+   *
+   * Successive calls on the same thread never go backwards, even across recalibrations.
+   */
+  time_point now() noexcept;
+
+ private:
+  tsc_clock();
+  void calibrate(std::uint64_t ticks, std::int64_t ns, double ns_per_tick) noexcept;
+  void maybe_recalibrate(std::uint64_t ticks) noexcept;
+
+  bool available_;
+
+  // The published calibration, guarded by seq_.
+  std::atomic<std::uint32_t> seq_{0};
+  std::atomic<std::uint64_t> base_ticks_{0};
+  std::atomic<std::int64_t> base_ns_{0};
+  std::atomic<double> ns_per_tick_{1.0};
+  std::atomic<std::uint64_t> next_calibration_{0};
+
+  // The last raw (ticks, system time) sample, only touched while holding calibration_mutex_.
+  std::mutex calibration_mutex_;
+  std::uint64_t sample_ticks_{0};
+  std::int64_t sample_ns_{0};
+};
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "crash_flush.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+// TODO: Check if the below issue persists
+// This issue claims to have been resolved in gcc 8, but we still seem to encounter it here.
+// The code compiles and links and all tests pass, and nm shows symbols resolved as expected.
+// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=80947
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+#include <spdlog/details/log_msg.h>
+#pragma GCC diagnostic pop
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+
+/**
+ * @brief Interface for the logger that writer threads hand records to.
+ */
+class record_writer {
+ public:
+  virtual ~record_writer() = default;
+
+  /**
+   * @brief Write a record to the sinks.
+   *
+   * Called from the writer threads, with the logging thread's context fields installed as the
+   * writer thread's context.
+   *
+   * @param msg The record, with the logging thread's id and timestamp
+   */
+  virtual void write_record(const spdlog::details::log_msg& msg) = 0;
+};
+
+/**
+ * @brief Background threads that write a logger's records.
+ *
+ * Each writer has a queue of two fixed-size arenas: logging threads append records to one while
+ * the writer writes out the other. Logging threads are assigned to writers round-robin.
+ */
+class writer_pool {
+ public:
+  /**
+   * @brief Start the writers.
+   *
+   * Returns once every writer has pinned itself and allocated its queue.
+   *
+   * @param options The configuration of the writers
+   * @param clock The clock used to timestamp records
+   * @param logger_name The name of the logger, which must outlive the pool
+   * @param target The logger to write records to, which must outlive the pool
+   *
+   * @throws std::invalid_argument if the options are invalid
+   * @throws std::system_error if a writer cannot be pinned
+   */
+  writer_pool(async_options const& options,
+              clock_source clock,
+              std::string const& logger_name,
+              record_writer& target);
+
+  /**
+   * @brief Write the queued records and stop the writers.
+   */
+  ~writer_pool();
+
+  writer_pool(writer_pool const&)            = delete;
+  writer_pool& operator=(writer_pool const&) = delete;
+
+  /**
+   * @brief Queue a record for the calling thread's writer, or write it if it never fits the queue.
+   *
+   * @param lvl The level of the record
+   * @param message The message
+   * @return false if the record was dropped
+   */
+  bool push(level_enum lvl, std::string_view message);
+
+  /**
+   * @brief Wait until the records queued before the call have been written.
+   */
+  void flush();
+
+  /**
+   * @brief Wait until the records the calling thread queued before the call have been written.
+   */
+  void flush_calling_thread();
+
+  /**
+   * @brief Write the records still queued to the given sinks, from the crash handler.
+   *
+   * Only async-signal-safe operations are used, so the records are written unformatted.
+   *
+   * @param sinks The sinks to write to, in which null entries are skipped
+   */
+  void emergency_write(std::span<std::atomic<crash_flushable*> const> sinks) const noexcept;
+
+ private:
+  class writer;
+  std::vector<std::unique_ptr<writer>> writers_;
+};
+
+}  // namespace detail
+}  // namespace rapids_logger
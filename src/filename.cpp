@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/filename.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+std::string pid() { return std::to_string(::getpid()); }
+
+std::string hostname()
+{
+  std::array<char, HOST_NAME_MAX + 1> name{};
+  if (::gethostname(name.data(), name.size() - 1) != 0) { return "unknown"; }
+  return name.data();
+}
+
+}  // namespace
+
+std::string process_rank()
+{
+  // The variables set by the launchers in common use, in order of preference.
+  for (auto const* variable :
+       {"RAPIDS_LOGGER_RANK", "OMPI_COMM_WORLD_RANK", "PMI_RANK", "SLURM_PROCID"}) {
+    if (auto const* value = std::getenv(variable); value != nullptr && *value != '\0') {
+      return value;
+    }
+  }
+  return "0";
+}
+
+std::string expand_filename(std::string const& filename)
+{
+  struct placeholder {
+    std::string_view text;
+    std::string (*value)();
+  };
+  constexpr std::array<placeholder, 3> placeholders{
+    {{"{pid}", pid}, {"{hostname}", hostname}, {"{rank}", process_rank}}};
+
+  std::string result;
+  std::string_view rest{filename};
+  while (!rest.empty()) {
+    auto const open = rest.find('{');
+    result.append(rest.substr(0, open));
+    if (open == std::string_view::npos) { break; }
+    rest.remove_prefix(open);
+    auto const match = std::find_if(placeholders.begin(), placeholders.end(), [&](auto const& p) {
+      return rest.substr(0, p.text.size()) == p.text;
+    });
+    if (match != placeholders.end()) {
+      result += match->value();
+      rest.remove_prefix(match->text.size());
+    } else {
+      result += '{';
+      rest.remove_prefix(1);
+    }
+  }
+  return result;
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -3,6 +3,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "detail/context.hpp"
+#include "detail/crash_flush.hpp"
+#include "detail/filename.hpp"
+#include "detail/sharded_counters.hpp"
+#include "detail/sink_impl.hpp"
+#include "detail/spans.hpp"
+#include "detail/tsc_clock.hpp"
+#include "detail/writer_pool.hpp"
+
 #include <rapids_logger/logger.hpp>
 
 // TODO: Check if the below issue persists
@@ -13,19 +22,33 @@
 #pragma GCC diagnostic ignored "-Wattributes"
 
 #include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/base_sink.h>
-#include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/null_sink.h>
-#include <spdlog/sinks/ostream_sink.h>
-#include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
 #pragma GCC diagnostic pop
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace rapids_logger {
 
@@ -77,29 +100,269 @@ level_enum from_spdlog_level(spdlog::level::level_enum lvl)
 }  // namespace
 
 /**
- * @brief The sink_impl class is a wrapper around an spdlog sink.
+ * @brief An spdlog logger that formats each record at most once for all of its sinks.
  *
- * This class is the impl part of the PImpl for the sink.
+ * spdlog's logger hands every record to each sink, which then formats it with its own formatter.
+ * All sinks attached to a logger use the logger's pattern, so sinks that can accept a formatted
+ * record instead share a single buffer formatted by the logger. Other sinks (e.g. the null sink,
+ * which never formats) are handed the record as usual.
  */
-class sink_impl {
+class fanout_logger : public spdlog::logger, public record_writer {
  public:
-  sink_impl(std::shared_ptr<spdlog::sinks::sink> sink) : underlying{sink} {}
+  explicit fanout_logger(std::string name)
+    : spdlog::logger{std::move(name)},
+      formatter_{std::make_unique<spdlog::pattern_formatter>()},
+      generation_{next_generation()},
+      id_{next_generation()}
+  {
+  }
+
+  ~fanout_logger() override
+  {
+    // Threads drop their clones of the formatter the next time they log.
+    alive_.reset();
+    loggers_destroyed().fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Set the pattern used to format records for the sinks.
+   *
+   * @param pattern The pattern
+   */
+  void set_pattern(std::string pattern)
+  {
+    auto formatter = make_formatter(std::move(pattern));
+    // Sinks that are not handed formatted records still need their own copy.
+    spdlog::logger::set_formatter(formatter->clone());
+    std::lock_guard lock{formatter_mutex_};
+    formatter_ = std::move(formatter);
+    generation_.store(next_generation(), std::memory_order_release);
+  }
+
+  void write_record(const spdlog::details::log_msg& msg) override { sink_it_(msg); }
+
+  /**
+   * @brief Set a function called before every flush of the sinks.
+   *
+   * The function is called for flushes requested with flush() as well as those triggered by
+   * flush_on().
+   *
+   * @param hook The function
+   */
+  void set_flush_hook(std::function<void()> hook) { flush_hook_ = std::move(hook); }
+
+  /**
+   * @brief Hand spans recorded for this logger to the sinks that write spans.
+   *
+   * @param events The spans
+   */
+  void write_spans(std::vector<span_event> const& events)
+  {
+    for (auto& s : sinks_) {
+      try {
+        static_cast<instrumented_sink&>(*s).write_spans(name_, events);
+      } catch (std::exception const& ex) {
+        err_handler_(ex.what());
+      }
+    }
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    scratch_buffer formatted;
+    bool is_formatted{false};
+    for (auto& s : sinks_) {
+      if (!s->should_log(msg.level)) { continue; }
+      // Every sink attached through a sink_vector is instrumented.
+      auto& sink = static_cast<instrumented_sink&>(*s);
+      try {
+        if (sink.accepts_formatted()) {
+          if (!is_formatted) {
+            thread_formatter().format(msg, formatted.buffer());
+            is_formatted = true;
+          }
+          sink.log_formatted(msg, formatted.buffer());
+        } else {
+          sink.log(msg);
+        }
+      } catch (std::exception const& ex) {
+        err_handler_(ex.what());
+      } catch (...) {
+        err_handler_("Rethrowing unknown exception in logger");
+        throw;
+      }
+    }
+    if (should_flush_(msg)) { flush_(); }
+  }
+
+  void flush_() override
+  {
+    if (flush_hook_) {
+      try {
+        flush_hook_();
+      } catch (std::exception const& ex) {
+        err_handler_(ex.what());
+      }
+    }
+    spdlog::logger::flush_();
+  }
 
  private:
-  std::shared_ptr<spdlog::sinks::sink> underlying;
-  // The sink_vector needs to be able to pass the underlying sink to the spdlog logger.
-  friend class logger::sink_vector;
+  /**
+   * @brief Get a new formatter generation, unique across all loggers.
+   */
+  static std::uint64_t next_generation() noexcept
+  {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of fanout loggers destroyed so far.
+   */
+  static std::atomic<std::uint64_t>& loggers_destroyed() noexcept
+  {
+    static std::atomic<std::uint64_t> count{0};
+    return count;
+  }
+
+  /**
+   * @brief Get the calling thread's copy of the formatter.
+   *
+   * Formatters cache time fields, so they cannot be shared between threads without a lock.
+   * Instead each thread keeps a clone of the formatter of every logger it logs to, tagged with the
+   * generation it was cloned from, and only clones a logger's formatter again once its pattern has
+   * changed. The clones of destroyed loggers are dropped the next time the thread logs.
+   */
+  spdlog::formatter& thread_formatter()
+  {
+    struct cached_formatter {
+      std::weak_ptr<void const> owner;  ///< Expires when the logger is destroyed
+      std::uint64_t generation{0};
+      std::unique_ptr<spdlog::formatter> formatter;
+    };
+    struct formatter_cache {
+      std::unordered_map<std::uint64_t, cached_formatter> entries;  ///< Keyed by logger id
+      std::uint64_t loggers_destroyed{0};                           ///< When entries were pruned
+    };
+    thread_local formatter_cache cache;
+
+    if (auto const destroyed = loggers_destroyed().load(std::memory_order_acquire);
+        destroyed != cache.loggers_destroyed) {
+      cache.loggers_destroyed = destroyed;
+      std::erase_if(cache.entries, [](auto const& entry) { return entry.second.owner.expired(); });
+    }
+    auto& entry = cache.entries[id_];
+    if (entry.formatter != nullptr &&
+        entry.generation == generation_.load(std::memory_order_acquire)) {
+      return *entry.formatter;
+    }
+    std::lock_guard lock{formatter_mutex_};
+    // The pattern may have changed since the generation was read.
+    entry.owner      = alive_;
+    entry.formatter  = formatter_->clone();
+    entry.generation = generation_.load(std::memory_order_relaxed);
+    return *entry.formatter;
+  }
+
+  /**
+   * @brief A formatting buffer that is reused across records logged by the same thread.
+   *
+   * A sink may log from within its own write (e.g. a callback sink), in which case the nested
+   * record gets a fresh buffer instead of clobbering the outer one.
+   */
+  class scratch_buffer {
+   public:
+    scratch_buffer() : owns_shared_{!shared_in_use}
+    {
+      if (owns_shared_) {
+        shared_in_use = true;
+        shared().clear();
+      }
+    }
+    ~scratch_buffer()
+    {
+      if (owns_shared_) { shared_in_use = false; }
+    }
+    scratch_buffer(scratch_buffer const&)            = delete;
+    scratch_buffer& operator=(scratch_buffer const&) = delete;
+
+    spdlog::memory_buf_t& buffer() { return owns_shared_ ? shared() : local_; }
+
+   private:
+    static spdlog::memory_buf_t& shared()
+    {
+      thread_local spdlog::memory_buf_t buffer;
+      return buffer;
+    }
+    static thread_local bool shared_in_use;
+
+    bool owns_shared_;
+    spdlog::memory_buf_t local_;
+  };
+
+  std::mutex formatter_mutex_;  ///< Guards replacing and cloning the formatter
+  std::unique_ptr<spdlog::formatter> formatter_;  ///< The formatter that threads clone
+  std::atomic<std::uint64_t> generation_;         ///< The generation of formatter_
+  std::uint64_t const id_;                        ///< Identifies the logger in thread caches
+  std::shared_ptr<void const> alive_{std::make_shared<char>()};  ///< Reset on destruction
+  std::function<void()> flush_hook_;              ///< Called before the sinks are flushed
+};
+
+thread_local bool fanout_logger::scratch_buffer::shared_in_use{false};
+
+namespace {
+
+/**
+ * @brief The memory that a thread's buffered_scope instances keep records in.
+ *
+ * Nested scopes share the arena, each using the part after its enclosing scope's records, so
+ * ending a scope only has to reset the used size to where the scope began.
+ */
+struct record_arena {
+  std::vector<char> data;
+  std::size_t used{0};
+  buffered_scope* scope{nullptr};  ///< The innermost scope
+};
+
+record_arena& thread_arena() noexcept
+{
+  thread_local record_arena arena;
+  return arena;
+}
+
+/**
+ * @brief The fixed-size part of a kept record, followed by the message and context text.
+ */
+struct kept_record {
+  std::uint32_t size;  ///< Size of the record including the header, padded for alignment
+  level_enum level;
+  std::uint32_t message_size;
+  std::uint32_t context_size;
+  spdlog::log_clock::time_point time;
 };
 
+constexpr std::size_t kept_size(std::size_t message_size, std::size_t context_size)
+{
+  auto const size = sizeof(kept_record) + message_size + context_size;
+  return (size + alignof(kept_record) - 1) / alignof(kept_record) * alignof(kept_record);
+}
+
+}  // namespace
+
 /**
  * @brief The logger_impl class is a wrapper around an spdlog logger.
  *
  * This class is the impl part of the PImpl for the logger.
  */
-class logger_impl {
+class logger_impl : public crash_flushable {
  public:
-  logger_impl(std::string name) : underlying{spdlog::logger{name}}
+  logger_impl(std::string name, clock_source clock = clock_source::system)
+    : underlying{name}, clock_{clock}
   {
+    // Spans are handed to the sinks whenever they are flushed, including by flush_on().
+    underlying.set_flush_hook([this] { write_spans(); });
     // TODO: Every consuming library will need to set its own default levels and pattern
     // underlying.set_pattern(default_pattern());
     // when creating a default logger instance instead of setting the variables
@@ -112,22 +375,391 @@ class logger_impl {
     // nullptr) { flush_on(detail::string_to_level(env_flush_level)); }
   }
 
-  void log(level_enum lvl, std::string const& message)
+  logger_impl(std::string name, clock_source clock, async_options const& options)
+    : logger_impl{std::move(name), clock}
+  {
+    writers_ = std::make_unique<writer_pool>(options, clock, underlying.name(), underlying);
+  }
+
+  ~logger_impl() override
   {
-    underlying.log(to_spdlog_level(lvl), message);
+    unregister_crash_flushable(this);
+    try {
+      write_spans();
+    } catch (...) {
+      // Spans that cannot be written are lost with the logger.
+    }
+    release_spans(span_owner_);
+  }
+
+  logger_impl(logger_impl const&)            = delete;
+  logger_impl& operator=(logger_impl const&) = delete;
+
+  void log(level_enum lvl, spdlog::string_view_t message)
+  {
+    // Check the level first so that filtered records do not pay for a clock read.
+    if (!should_format(lvl)) { return; }
+    prepare_crash_stack();
+    if (lvl >= level_enum::error) { fail_scopes(); }
+    if (auto* scope = buffering_scope(); scope != nullptr) {
+      if (!should_log(lvl)) {
+        keep(*scope, lvl, message);
+        return;
+      }
+    }
+    if (writers_) {
+      // A dropped record is only counted as dropped.
+      auto const pushed = writers_->push(lvl, {message.data(), message.size()});
+      counters_.add(pushed ? static_cast<std::size_t>(lvl) : dropped);
+      return;
+    }
+    counters_.add(static_cast<std::size_t>(lvl));
+    if (clock_ == clock_source::tsc) {
+      underlying.log(
+        tsc_clock::instance().now(), spdlog::source_loc{}, to_spdlog_level(lvl), message);
+    } else {
+      underlying.log(to_spdlog_level(lvl), message);
+    }
+  }
+  bool should_format(level_enum lvl)
+  {
+    // Records below the level still need to be formatted if a buffered_scope keeps them.
+    if (underlying.should_log(to_spdlog_level(lvl)) || buffering_scope() != nullptr) {
+      return true;
+    }
+    counters_.add(filtered);
+    return false;
   }
   void set_level(level_enum log_level) { underlying.set_level(to_spdlog_level(log_level)); }
-  void flush() { underlying.flush(); }
+  void flush()
+  {
+    if (writers_) { writers_->flush(); }
+    underlying.flush();
+  }
   void flush_on(level_enum log_level) { underlying.flush_on(to_spdlog_level(log_level)); }
   level_enum flush_level() const { return from_spdlog_level(underlying.flush_level()); }
   bool should_log(level_enum lvl) const { return underlying.should_log(to_spdlog_level(lvl)); }
   level_enum level() const { return from_spdlog_level(underlying.level()); }
   void set_pattern(std::string pattern) { underlying.set_pattern(pattern); }
+  clock_source clock() const { return clock_; }
+  void flush_on_crash(bool enable)
+  {
+    if (!enable) {
+      unregister_crash_flushable(this);
+    } else if (!crash_flush_ && !register_crash_flushable(this)) {
+      throw std::length_error("Too many loggers are registered to be flushed on crash");
+    }
+    crash_flush_ = enable;
+  }
+  void emergency_flush() noexcept override
+  {
+    for (auto const& slot : crash_sinks_) {
+      if (auto* target = slot.load(std::memory_order_acquire)) { target->emergency_flush(); }
+    }
+    // Records still queued for the writers were logged after those the sinks buffered.
+    if (writers_) { writers_->emergency_write(crash_sinks_); }
+  }
+
+  /**
+   * @brief Snapshot the sinks that the crash handler writes out.
+   *
+   * The crash handler may interrupt a thread that is changing the sinks, so it walks this fixed
+   * array instead of the sink vector. Must be called after every change to the sinks, before
+   * any sink that was removed may be destroyed.
+   */
+  void update_crash_sinks() noexcept
+  {
+    std::size_t n{0};
+    for (auto const& s : underlying.sinks()) {
+      auto* target = static_cast<instrumented_sink&>(*s).crash_target();
+      if (target != nullptr && n < crash_sinks_.size()) {
+        crash_sinks_[n++].store(target, std::memory_order_release);
+      }
+    }
+    for (; n < crash_sinks_.size(); ++n) {
+      crash_sinks_[n].store(nullptr, std::memory_order_release);
+    }
+  }
+  logger_metrics metrics() const
+  {
+    auto const totals = counters_.sum();
+    logger_metrics result{};
+    std::copy(totals.begin(), totals.begin() + n_levels, result.messages.begin());
+    result.filtered = totals[filtered];
+    result.dropped  = totals[dropped];
+    return result;
+  }
   const std::vector<spdlog::sink_ptr>& sinks() const { return underlying.sinks(); }
   std::vector<spdlog::sink_ptr>& sinks() { return underlying.sinks(); }
+  std::uint64_t span_owner() const { return span_owner_; }
+
+  /**
+   * @brief Write out or discard the records kept by a scope that is ending.
+   *
+   * @param scope The scope
+   */
+  void end_scope(buffered_scope const& scope)
+  {
+    if (!scope.failed_) {
+      counters_.add(filtered, scope.records_);
+      return;
+    }
+    // The kept records are written on this thread, so they must not overtake the records the
+    // thread queued for its writer before the scope ended.
+    if (writers_) { writers_->flush_calling_thread(); }
+    auto& arena   = thread_arena();
+    auto& context = current_context();
+    auto const saved = context;
+    try {
+      for (auto offset = scope.begin_; offset < arena.used;) {
+        auto const* record = arena.data.data() + offset;
+        kept_record header;
+        std::memcpy(&header, record, sizeof(header));
+        auto const* message = record + sizeof(header);
+        context.assign({message + header.message_size, header.context_size});
+        spdlog::details::log_msg const msg{header.time,
+                                           spdlog::source_loc{},
+                                           underlying.name(),
+                                           to_spdlog_level(header.level),
+                                           {message, header.message_size}};
+        counters_.add(static_cast<std::size_t>(header.level));
+        underlying.write_record(msg);
+        offset += header.size;
+      }
+    } catch (...) {
+      context = saved;
+      throw;
+    }
+    context = saved;
+  }
+
+ private:
+  /**
+   * @brief Get the calling thread's innermost buffered_scope if it keeps this logger's records.
+   */
+  buffered_scope* buffering_scope() const noexcept
+  {
+    auto* scope = thread_arena().scope;
+    return (scope != nullptr && scope->impl_ == this) ? scope : nullptr;
+  }
+
+  /**
+   * @brief Fail every scope of this logger that is open on the calling thread.
+   *
+   * An error fails the unit of work of each enclosing scope, not only the innermost one.
+   */
+  void fail_scopes() const noexcept
+  {
+    for (auto* scope = thread_arena().scope; scope != nullptr; scope = scope->parent_) {
+      if (scope->impl_ == this) { scope->failed_ = true; }
+    }
+  }
+
+  /**
+   * @brief Keep a record below the level in the calling thread's arena.
+   */
+  void keep(buffered_scope& scope, level_enum lvl, spdlog::string_view_t message)
+  {
+    auto& arena        = thread_arena();
+    auto const context = current_context().view();
+    auto const size    = kept_size(message.size(), context.size());
+    if (arena.used + size > scope.end_) {
+      counters_.add(dropped);
+      return;
+    }
+    auto const time = (clock_ == clock_source::tsc) ? tsc_clock::instance().now()
+                                                    : spdlog::log_clock::now();
+    kept_record const header{static_cast<std::uint32_t>(size),
+                             lvl,
+                             static_cast<std::uint32_t>(message.size()),
+                             static_cast<std::uint32_t>(context.size()),
+                             time};
+    auto* out = arena.data.data() + arena.used;
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), message.data(), message.size());
+    std::memcpy(out + sizeof(header) + message.size(), context.data(), context.size());
+    arena.used += size;
+    ++scope.records_;
+  }
+
+  /**
+   * @brief Collect the spans recorded for this logger and write them to the sinks.
+   */
+  void write_spans()
+  {
+    std::vector<span_event> events;
+    auto const n_dropped = collect_spans(span_owner_, events);
+    if (n_dropped > 0) { counters_.add(dropped, n_dropped); }
+    if (!events.empty()) { underlying.write_spans(events); }
+  }
+
+  // Counter indices: one per level, followed by the filtered and dropped counts.
+  static constexpr std::size_t n_levels = static_cast<std::size_t>(level_enum::n_levels);
+  static constexpr std::size_t filtered = n_levels;
+  static constexpr std::size_t dropped  = n_levels + 1;
+
+  // Buffered sinks beyond this number are not written out by the crash handler.
+  static constexpr std::size_t max_crash_sinks = 16;
+
+  fanout_logger underlying;                     ///< The spdlog logger
+  clock_source clock_;                          ///< The clock used to timestamp records
+  sharded_counters<n_levels + 2> counters_;     ///< Per-level, filtered and dropped counts
+  bool crash_flush_{false};                     ///< Whether the crash handler flushes the sinks
+  /// The buffered sinks, for the crash handler
+  std::array<std::atomic<crash_flushable*>, max_crash_sinks> crash_sinks_{};
+  std::uint64_t span_owner_{new_span_owner()};  ///< Identifies the spans recorded for the logger
+  // Declared last, so that the writers are stopped before anything they use is destroyed.
+  std::unique_ptr<writer_pool> writers_;  ///< The background writers, if any
+};
+
+/**
+ * @brief A sink that writes to a file.
+ *
+ * Records are buffered in memory and written with a single write(2) when the buffer fills up or
+ * the sink is flushed. The buffer is a fixed allocation that is published with an atomic size,
+ * so that the crash handler can write it out without locking. By default the buffer is the size
+ * that stdio would use for the file, so records reach the file as often as with a FILE*.
+ */
+template <class Mutex>
+class file_sink : public formatting_sink<Mutex>, public crash_flushable {
+ public:
+  /**
+   * @param filename The file name, which may contain placeholders
+   * @param truncate Whether to truncate the file
+   * @param buffer_size The size of the buffer, or 0 for the file's block size
+   */
+  file_sink(std::string const& filename, bool truncate, std::size_t buffer_size)
+    : filename_{expand_filename(filename)}
+  {
+    auto const parent = std::filesystem::path{filename_}.parent_path();
+    if (!parent.empty()) { std::filesystem::create_directories(parent); }
+    fd_ = ::open(filename_.c_str(),
+                 O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0),
+                 0644);
+    if (fd_ < 0) {
+      auto const error = errno;
+      throw std::runtime_error("Failed opening file " + filename_ + " for writing: " +
+                               std::strerror(error));
+    }
+    if (buffer_size == 0) {
+      // Like glibc's stdio, use the file's preferred block size.
+      struct stat st {};
+      buffer_size = (::fstat(fd_, &st) == 0 && st.st_blksize > 0)
+                      ? static_cast<std::size_t>(st.st_blksize)
+                      : static_cast<std::size_t>(BUFSIZ);
+    }
+    buffer_capacity_ = buffer_size;
+    buffer_          = std::make_unique<char[]>(buffer_capacity_);
+  }
+
+  ~file_sink() override
+  {
+    write_all(fd_, buffer_.get(), buffered_.load(std::memory_order_relaxed));
+    ::close(fd_);
+  }
+
+  file_sink(file_sink const&)            = delete;
+  file_sink& operator=(file_sink const&) = delete;
+
+  void emergency_flush() noexcept override
+  {
+    write_all(fd_, buffer_.get(), buffered_.load(std::memory_order_acquire));
+  }
+
+  void emergency_write(char const* data, std::size_t size) noexcept override
+  {
+    write_all(fd_, data, size);
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg&, spdlog::memory_buf_t& formatted) override
+  {
+    auto const size = formatted.size();
+    auto used       = buffered_.load(std::memory_order_relaxed);
+    if (used + size > buffer_capacity_) {
+      write_buffer();
+      used = 0;
+    }
+    if (size > buffer_capacity_) {
+      write_or_throw(formatted.data(), size);
+      return true;
+    }
+    std::memcpy(buffer_.get() + used, formatted.data(), size);
+    buffered_.store(used + size, std::memory_order_release);
+    return true;
+  }
+
+  void flush_() override { write_buffer(); }
+
+ private:
+  void write_buffer()
+  {
+    auto const used = buffered_.load(std::memory_order_relaxed);
+    if (used == 0) { return; }
+    // Crashing during the write may duplicate some records in the file, but never loses them.
+    auto const written = write_all(fd_, buffer_.get(), used);
+    buffered_.store(0, std::memory_order_release);
+    if (!written) { throw_write_error(); }
+  }
+
+  void write_or_throw(char const* data, std::size_t size)
+  {
+    if (!write_all(fd_, data, size)) { throw_write_error(); }
+  }
+
+  [[noreturn]] void throw_write_error()
+  {
+    auto const error = errno;
+    throw std::runtime_error("Failed writing to file " + filename_ + ": " + std::strerror(error));
+  }
+
+  std::string filename_;
+  int fd_{-1};
+  std::size_t buffer_capacity_{0};
+  std::unique_ptr<char[]> buffer_;
+  std::atomic<std::size_t> buffered_{0};  ///< Bytes of the buffer holding unwritten records
+};
+
+/**
+ * @brief A sink that writes to an ostream.
+ */
+template <class Mutex>
+class ostream_sink : public formatting_sink<Mutex> {
+ public:
+  explicit ostream_sink(std::ostream& stream, bool force_flush)
+    : stream_{stream}, force_flush_{force_flush}
+  {
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg&, spdlog::memory_buf_t& formatted) override
+  {
+    stream_.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+    if (force_flush_) { stream_.flush(); }
+    return true;
+  }
+
+  void flush_() override { stream_.flush(); }
 
  private:
-  spdlog::logger underlying;  ///< The spdlog logger
+  std::ostream& stream_;
+  bool force_flush_;
+};
+
+/**
+ * @brief A sink that writes to stderr, flushing every record like spdlog's console sinks.
+ */
+template <class Mutex>
+class stderr_sink : public formatting_sink<Mutex> {
+ protected:
+  bool write_(const spdlog::details::log_msg&, spdlog::memory_buf_t& formatted) override
+  {
+    std::fwrite(formatted.data(), 1, formatted.size(), stderr);
+    std::fflush(stderr);
+    return true;
+  }
+
+  void flush_() override { std::fflush(stderr); }
 };
 
 // Default flush function
@@ -141,7 +773,7 @@ void default_flush() { std::cout << std::flush; }
  * to simplify this code.
  */
 template <class Mutex>
-class callback_sink : public spdlog::sinks::base_sink<Mutex> {
+class callback_sink : public formatting_sink<Mutex> {
  public:
   explicit callback_sink(log_callback_t callback, flush_callback_t flush = nullptr)
     : _callback{callback}, _flush{flush ? flush : default_flush}
@@ -149,17 +781,18 @@ class callback_sink : public spdlog::sinks::base_sink<Mutex> {
   }
 
  protected:
-  void sink_it_(const spdlog::details::log_msg& msg) override
+  bool write_(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) override
   {
-    spdlog::memory_buf_t formatted;
-    spdlog::sinks::base_sink<Mutex>::formatter_->format(msg, formatted);
-    std::string msg_string = std::string(formatted.data(), formatted.size());
-
     if (_callback) {
-      _callback(static_cast<int>(msg.level), msg_string.c_str());
+      // Terminate the buffer in place rather than copying it into a std::string.
+      auto const size = formatted.size();
+      formatted.push_back('\0');
+      _callback(static_cast<int>(msg.level), formatted.data());
+      formatted.resize(size);
     } else {
-      std::cout << msg_string;
+      std::cout.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
     }
+    return true;
   }
 
   void flush_() override { _flush(); }
@@ -175,21 +808,28 @@ void logger::sink_vector::push_back(sink_ptr const& sink)
 {
   sinks_.push_back(sink);
   parent.impl->sinks().push_back(sink->impl->underlying);
+  parent.impl->update_crash_sinks();
 }
 void logger::sink_vector::push_back(sink_ptr&& sink)
 {
   sinks_.push_back(sink);
   parent.impl->sinks().push_back(sink->impl->underlying);
+  parent.impl->update_crash_sinks();
 }
 void logger::sink_vector::pop_back()
 {
+  // Keep the sink alive until the crash handler no longer writes it out.
+  auto const removed = std::move(parent.impl->sinks().back());
   sinks_.pop_back();
   parent.impl->sinks().pop_back();
+  parent.impl->update_crash_sinks();
 }
 void logger::sink_vector::clear()
 {
+  auto const removed = std::move(parent.impl->sinks());
   sinks_.clear();
   parent.impl->sinks().clear();
+  parent.impl->update_crash_sinks();
 }
 
 // Sink methods
@@ -197,15 +837,29 @@ sink::sink(std::unique_ptr<detail::sink_impl> impl) : impl{std::move(impl)} {}
 
 sink::~sink() = default;
 
+sink_metrics sink::metrics() const { return impl->underlying->metrics(); }
+void sink::set_level(level_enum log_level)
+{
+  impl->underlying->set_level(detail::to_spdlog_level(log_level));
+}
+level_enum sink::level() const { return detail::from_spdlog_level(impl->underlying->level()); }
+
 basic_file_sink_mt::basic_file_sink_mt(std::string const& filename, bool truncate)
+  : basic_file_sink_mt{filename, truncate, 0}
+{
+}
+
+basic_file_sink_mt::basic_file_sink_mt(std::string const& filename,
+                                       bool truncate,
+                                       std::size_t buffer_size)
   : sink{std::make_unique<detail::sink_impl>(
-      std::make_shared<spdlog::sinks::basic_file_sink_mt>(filename, truncate))}
+      std::make_shared<detail::file_sink<std::mutex>>(filename, truncate, buffer_size))}
 {
 }
 
 ostream_sink_mt::ostream_sink_mt(std::ostream& stream, bool force_flush)
   : sink{std::make_unique<detail::sink_impl>(
-      std::make_shared<spdlog::sinks::ostream_sink_mt>(stream, force_flush))}
+      std::make_shared<detail::ostream_sink<std::mutex>>(stream, force_flush))}
 {
 }
 
@@ -215,7 +869,7 @@ null_sink_mt::null_sink_mt()
 }
 
 stderr_sink_mt::stderr_sink_mt()
-  : sink{std::make_unique<detail::sink_impl>(std::make_shared<spdlog::sinks::stderr_sink_mt>())}
+  : sink{std::make_unique<detail::sink_impl>(std::make_shared<detail::stderr_sink<std::mutex>>())}
 {
 }
 
@@ -246,6 +900,27 @@ logger::logger(std::string name, std::vector<sink_ptr> sinks)
   }
 }
 
+logger::logger(std::string name, std::vector<sink_ptr> sinks, clock_source clock)
+  : impl{std::make_unique<detail::logger_impl>(name, clock)}, sinks_{*this}
+{
+  // Calibrate up front rather than on the first logged record.
+  if (clock == clock_source::tsc) { detail::tsc_clock::instance(); }
+  for (auto const& s : sinks) {
+    sinks_.push_back(s);
+  }
+}
+
+logger::logger(std::string name,
+               std::vector<sink_ptr> sinks,
+               async_options const& options,
+               clock_source clock)
+  : impl{std::make_unique<detail::logger_impl>(name, clock, options)}, sinks_{*this}
+{
+  for (auto const& s : sinks) {
+    sinks_.push_back(s);
+  }
+}
+
 logger::~logger()              = default;
 logger::logger(logger&& other) = default;
 logger& logger::operator=(logger&& other)
@@ -258,15 +933,73 @@ logger& logger::operator=(logger&& other)
   return *this;
 }
 
-void logger::log(level_enum lvl, std::string const& message) { impl->log(lvl, message); }
+void logger::log(level_enum lvl, std::string const& message)
+{
+  impl->log(lvl, {message.data(), message.size()});
+}
+void logger::log(level_enum lvl, std::string_view message)
+{
+  impl->log(lvl, {message.data(), message.size()});
+}
+void logger::log(level_enum lvl, char const* message)
+{
+  impl->log(lvl, {message, std::strlen(message)});
+}
 void logger::set_level(level_enum log_level) { impl->set_level(log_level); }
 void logger::flush() { impl->flush(); }
 void logger::flush_on(level_enum log_level) { impl->flush_on(log_level); }
 level_enum logger::flush_level() const { return impl->flush_level(); }
 bool logger::should_log(level_enum lvl) const { return impl->should_log(lvl); }
+bool logger::should_format(level_enum lvl) { return impl->should_format(lvl); }
 level_enum logger::level() const { return impl->level(); }
 void logger::set_pattern(std::string pattern) { impl->set_pattern(pattern); }
+clock_source logger::clock() const { return impl->clock(); }
+void logger::flush_on_crash(bool enable) { impl->flush_on_crash(enable); }
+logger_metrics logger::metrics() const
+{
+  auto result = impl->metrics();
+  for (auto const& s : sinks_) {
+    result.sinks.push_back(s->metrics());
+  }
+  return result;
+}
 const logger::sink_vector& logger::sinks() const { return sinks_; }
 logger::sink_vector& logger::sinks() { return sinks_; }
 
+buffered_scope::buffered_scope(logger& logger, std::size_t capacity)
+  : impl_{logger.impl.get()}
+{
+  auto& arena = detail::thread_arena();
+  parent_     = arena.scope;
+  begin_      = arena.used;
+  end_        = begin_ + capacity;
+  if (arena.data.size() < end_) { arena.data.resize(end_); }
+  arena.scope = this;
+}
+
+buffered_scope::~buffered_scope()
+{
+  try {
+    impl_->end_scope(*this);
+  } catch (...) {
+    // Records that cannot be written are lost with the scope.
+  }
+  auto& arena = detail::thread_arena();
+  arena.used  = begin_;
+  arena.scope = parent_;
+}
+
+span_scope::span_scope(logger& logger, level_enum lvl, char const* name)
+  : owner_{logger.should_log(lvl) ? logger.impl->span_owner() : 0},
+    name_{name},
+    level_{lvl},
+    start_{(owner_ != 0) ? detail::span_ticks() : 0}
+{
+}
+
+span_scope::~span_scope()
+{
+  if (owner_ != 0) { detail::record_span(owner_, name_, level_, start_, detail::span_ticks()); }
+}
+
 }  // namespace rapids_logger
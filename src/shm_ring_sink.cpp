@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/shm_ring.hpp"
+#include "detail/sink_impl.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+constexpr std::size_t min_capacity = 4096;
+
+/**
+ * @brief Claims the name of a ring for one sink of the process.
+ *
+ * A ring has a single producer, so two sinks of one process may not share a name.
+ */
+class ring_claim {
+ public:
+  explicit ring_claim(std::string const& object_name) : object_name_{object_name}
+  {
+    std::lock_guard lock{mutex()};
+    if (!claimed().insert(object_name_).second) {
+      throw std::runtime_error("Shared memory ring " + object_name_ +
+                               " is already used by another sink of this process");
+    }
+  }
+  ~ring_claim()
+  {
+    std::lock_guard lock{mutex()};
+    claimed().erase(object_name_);
+  }
+
+  ring_claim(ring_claim const&)            = delete;
+  ring_claim& operator=(ring_claim const&) = delete;
+
+ private:
+  static std::mutex& mutex()
+  {
+    static std::mutex m;
+    return m;
+  }
+  static std::set<std::string>& claimed()
+  {
+    static std::set<std::string> names;
+    return names;
+  }
+
+  std::string object_name_;
+};
+
+/**
+ * @brief A sink that publishes formatted records to a ring in shared memory.
+ *
+ * The ring is created at construction with shm_open and mapped for the lifetime of the sink, so
+ * writing a record is a memcpy and an atomic store. A separate collector process drains the
+ * rings of many processes. If a ring is full because the collector is slow or gone, records are
+ * dropped and counted rather than waiting for space.
+ */
+template <class Mutex>
+class shm_ring_sink : public formatting_sink<Mutex> {
+ public:
+  shm_ring_sink(std::string const& name, std::size_t capacity)
+    : capacity_{std::bit_ceil(std::max(capacity, min_capacity))},
+      object_name_{shm_ring::object_name(name, ::getpid())},
+      claim_{object_name_}
+  {
+    auto fd = ::shm_open(object_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+      // No sink of this process uses the ring, so it was left by an earlier sink of this process,
+      // or by an earlier process with the same pid, and was not collected.
+      ::shm_unlink(object_name_.c_str());
+      fd = ::shm_open(object_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+      throw std::runtime_error("Failed creating shared memory ring " + object_name_ + ": " +
+                               std::strerror(errno));
+    }
+    auto const size = shm_ring::data_offset + capacity_;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      ::shm_unlink(object_name_.c_str());
+      throw std::runtime_error("Failed sizing shared memory ring " + object_name_ + ": " +
+                               std::strerror(error));
+    }
+    mapping_ = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+      ::shm_unlink(object_name_.c_str());
+      throw std::runtime_error("Failed mapping shared memory ring " + object_name_);
+    }
+
+    auto* control = new (mapping_) shm_ring::header{};
+    control->version  = shm_ring::version;
+    control->capacity = capacity_;
+    control->pid      = ::getpid();
+    // Publishing the magic last tells collectors that the ring is ready.
+    std::atomic_ref<std::uint64_t>{control->magic}.store(shm_ring::magic,
+                                                          std::memory_order_release);
+    ring_ = std::make_unique<shm_ring::ring>(mapping_);
+  }
+
+  ~shm_ring_sink() override
+  {
+    // The collector unlinks the ring once it has drained it.
+    ring_->control().closed.store(1, std::memory_order_release);
+    ::munmap(mapping_, shm_ring::data_offset + capacity_);
+  }
+
+  shm_ring_sink(shm_ring_sink const&)            = delete;
+  shm_ring_sink& operator=(shm_ring_sink const&) = delete;
+
+  std::uint64_t dropped() const noexcept override
+  {
+    return ring_->control().dropped.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) override
+  {
+    auto const timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    return ring_->try_write(
+      static_cast<std::int32_t>(msg.level), timestamp_ns, formatted.data(), formatted.size());
+  }
+
+  // Records are visible to the collector as soon as they are published.
+  void flush_() override {}
+
+ private:
+  std::size_t capacity_;
+  std::string object_name_;
+  ring_claim claim_;
+  void* mapping_{nullptr};
+  std::unique_ptr<shm_ring::ring> ring_;
+};
+
+}  // namespace
+}  // namespace detail
+
+shm_ring_sink_mt::shm_ring_sink_mt(std::string const& name, std::size_t capacity)
+  : sink{std::make_unique<detail::sink_impl>(
+      std::make_shared<detail::shm_ring_sink<std::mutex>>(name, capacity))}
+{
+}
+
+}  // namespace rapids_logger
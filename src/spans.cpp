@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/spans.hpp"
+
+#include "detail/tsc_clock.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+#include <spdlog/details/os.h>
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+/**
+ * @brief The spans recorded by one thread for one owner.
+ *
+ * A single-producer, single-consumer ring: the recording thread advances head and the collector,
+ * which holds the registry mutex, advances tail.
+ */
+struct span_ring {
+  static constexpr std::uint64_t capacity = 1 << 12;
+
+  struct record {
+    char const* name;
+    level_enum level;
+    std::uint64_t start;
+    std::uint64_t end;
+  };
+
+  span_ring(std::uint64_t owner, std::size_t thread_id)
+    : owner{owner}, thread_id{thread_id}, records{std::make_unique<record[]>(capacity)}
+  {
+  }
+
+  std::uint64_t const owner;
+  std::size_t const thread_id;
+  std::unique_ptr<record[]> records;
+  std::atomic<std::uint64_t> head{0};
+  std::atomic<std::uint64_t> tail{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<bool> released{false};       ///< Whether the owner has been destroyed
+  std::atomic<bool> thread_exited{false};  ///< Whether the recording thread has exited
+};
+
+/**
+ * @brief The rings of all threads, for collection.
+ */
+struct ring_registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<span_ring>> rings;
+};
+
+ring_registry& registry()
+{
+  // Never destroyed, because loggers with static storage duration collect spans when they are
+  // destroyed, which may be after the registry would have been.
+  static auto* instance = new ring_registry;
+  return *instance;
+}
+
+/**
+ * @brief The calling thread's rings, one per owner it has recorded spans for.
+ */
+class thread_rings {
+ public:
+  ~thread_rings()
+  {
+    // The registry keeps the rings until their remaining spans are collected.
+    for (auto const& ring : rings_) {
+      ring->thread_exited.store(true, std::memory_order_release);
+    }
+  }
+
+  span_ring* find(std::uint64_t owner)
+  {
+    if (last_ != nullptr && last_->owner == owner) { return last_; }
+    rings_.erase(std::remove_if(rings_.begin(),
+                                rings_.end(),
+                                [](auto const& ring) { return ring->released.load(); }),
+                 rings_.end());
+    auto it = std::find_if(
+      rings_.begin(), rings_.end(), [&](auto const& ring) { return ring->owner == owner; });
+    if (it == rings_.end()) {
+      auto ring = std::make_shared<span_ring>(owner, spdlog::details::os::thread_id());
+      {
+        auto& r = registry();
+        std::lock_guard lock{r.mutex};
+        r.rings.push_back(ring);
+      }
+      rings_.push_back(std::move(ring));
+      it = rings_.end() - 1;
+    }
+    last_ = it->get();
+    return last_;
+  }
+
+ private:
+  std::vector<std::shared_ptr<span_ring>> rings_;
+  span_ring* last_{nullptr};  ///< The most recently used ring
+};
+
+}  // namespace
+
+std::uint64_t span_ticks() noexcept
+{
+  if (tsc_clock::instance().available()) { return tsc_clock::ticks(); }
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count());
+}
+
+std::chrono::system_clock::time_point span_time(std::uint64_t ticks) noexcept
+{
+  auto& clock = tsc_clock::instance();
+  if (clock.available()) { return clock.to_time_point(ticks); }
+  return std::chrono::system_clock::time_point{std::chrono::duration_cast<
+    std::chrono::system_clock::duration>(std::chrono::nanoseconds{ticks})};
+}
+
+std::uint64_t new_span_owner() noexcept
+{
+  static std::atomic<std::uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_span(std::uint64_t owner,
+                 char const* name,
+                 level_enum level,
+                 std::uint64_t start,
+                 std::uint64_t end) noexcept
+{
+  thread_local thread_rings rings;
+  span_ring* ring{nullptr};
+  try {
+    ring = rings.find(owner);
+  } catch (std::bad_alloc const&) {
+    return;
+  }
+  auto const head = ring->head.load(std::memory_order_relaxed);
+  if (head - ring->tail.load(std::memory_order_acquire) == span_ring::capacity) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ring->records[head % span_ring::capacity] = {name, level, start, end};
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+std::uint64_t collect_spans(std::uint64_t owner, std::vector<span_event>& events)
+{
+  auto& r = registry();
+  std::lock_guard lock{r.mutex};
+  std::uint64_t dropped{0};
+  for (auto const& ring : r.rings) {
+    if (ring->owner != owner) { continue; }
+    auto const tail = ring->tail.load(std::memory_order_relaxed);
+    auto const head = ring->head.load(std::memory_order_acquire);
+    for (auto i = tail; i != head; ++i) {
+      auto const& record = ring->records[i % span_ring::capacity];
+      events.push_back({record.name, record.level, record.start, record.end, ring->thread_id});
+    }
+    ring->tail.store(head, std::memory_order_release);
+    dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+  }
+  // Rings of exited threads are no longer written to once they have been collected.
+  r.rings.erase(std::remove_if(r.rings.begin(),
+                               r.rings.end(),
+                               [&](auto const& ring) {
+                                 return ring->owner == owner &&
+                                        ring->thread_exited.load(std::memory_order_acquire) &&
+                                        ring->tail.load(std::memory_order_relaxed) ==
+                                          ring->head.load(std::memory_order_relaxed);
+                               }),
+                r.rings.end());
+  return dropped;
+}
+
+void release_spans(std::uint64_t owner) noexcept
+{
+  auto& r = registry();
+  std::lock_guard lock{r.mutex};
+  r.rings.erase(std::remove_if(r.rings.begin(),
+                               r.rings.end(),
+                               [&](auto const& ring) {
+                                 if (ring->owner != owner) { return false; }
+                                 ring->released.store(true, std::memory_order_relaxed);
+                                 return true;
+                               }),
+                r.rings.end());
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,352 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/sink_impl.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+/**
+ * @brief Formatted records waiting to be written, with the metadata needed to write them.
+ */
+struct record_queue {
+  struct entry {
+    spdlog::level::level_enum level;
+    spdlog::log_clock::time_point time;
+    std::size_t end;  ///< End of the record's text
+  };
+
+  std::vector<char> text;
+  std::vector<entry> entries;
+
+  bool empty() const noexcept { return entries.empty(); }
+  void clear() noexcept
+  {
+    text.clear();
+    entries.clear();
+  }
+};
+
+/**
+ * @brief Unlock a mutex for the lifetime of the object, and lock it again on destruction.
+ */
+template <class Mutex>
+class unlock_guard {
+ public:
+  explicit unlock_guard(Mutex& mutex) : mutex_{mutex} { mutex_.unlock(); }
+  ~unlock_guard() { mutex_.lock(); }
+
+  unlock_guard(unlock_guard const&)            = delete;
+  unlock_guard& operator=(unlock_guard const&) = delete;
+
+ private:
+  Mutex& mutex_;
+};
+
+/**
+ * @brief The state shared by a stall guard and its writer thread.
+ *
+ * The writer owns a reference to the state, so that a guard whose writer is stuck in the
+ * decorated sink can be destroyed without waiting for the write to return.
+ */
+struct guard_state {
+  explicit guard_state(std::shared_ptr<instrumented_sink> inner) : inner{std::move(inner)} {}
+
+  std::shared_ptr<instrumented_sink> const inner;
+
+  std::mutex mutex;
+  std::condition_variable work;
+  std::condition_variable flushed;
+  std::condition_variable exited;
+  record_queue pending;  ///< Filled by logging threads
+  record_queue writing;  ///< Owned by the writer thread
+  std::uint64_t flushes_requested{0};
+  std::uint64_t flushes_done{0};
+  bool stop{false};
+  bool writer_exited{false};
+  std::string error;  ///< An error of the decorated sink not yet reported to a logging thread
+
+  std::atomic<bool> abandoned{false};            ///< Whether the guard stopped waiting for it
+  std::atomic<std::size_t> queued{0};            ///< Records queued or being written
+  std::atomic<std::int64_t> in_flight_since{0};  ///< Start of the current write, or 0
+};
+
+/**
+ * @brief Run an operation on the decorated sink, publishing when it started for the monitor.
+ */
+template <typename F>
+void timed(guard_state& state, F&& operation)
+{
+  state.in_flight_since.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                              std::memory_order_relaxed);
+  std::string error;
+  try {
+    operation();
+  } catch (std::exception const& ex) {
+    error = ex.what();
+  } catch (...) {
+    error = "Unknown exception in the sink";
+  }
+  state.in_flight_since.store(0, std::memory_order_relaxed);
+  if (!error.empty()) {
+    // Errors are handed to the next logging thread, which reports them to its logger.
+    std::lock_guard lock{state.mutex};
+    if (state.error.empty()) { state.error = std::move(error); }
+  }
+}
+
+void write_record(guard_state& state, record_queue::entry const& entry, spdlog::string_view_t text)
+{
+  if (!state.inner->should_log(entry.level)) { return; }
+  spdlog::details::log_msg msg{entry.time, spdlog::source_loc{}, "", entry.level, text};
+  timed(state, [&] {
+    if (state.inner->accepts_formatted()) {
+      // The text is only modified temporarily by sinks, and is owned by the writer thread.
+      spdlog::memory_buf_t formatted;
+      formatted.append(text.data(), text.data() + text.size());
+      state.inner->log_formatted(msg, formatted);
+    } else {
+      state.inner->log(msg);
+    }
+  });
+}
+
+/**
+ * @brief The writer thread: drain the queue into the decorated sink until stopped.
+ */
+void write_records(std::shared_ptr<guard_state> state_ptr)
+{
+  auto& state = *state_ptr;
+  std::unique_lock lock{state.mutex};
+  while (true) {
+    state.work.wait(lock, [&] {
+      return state.stop || !state.pending.empty() || state.flushes_done < state.flushes_requested;
+    });
+    auto const flush_target = state.flushes_requested;
+    std::swap(state.pending, state.writing);
+    lock.unlock();
+
+    std::size_t begin{0};
+    for (auto const& entry : state.writing.entries) {
+      // The records of an abandoned writer were counted as dropped.
+      if (state.abandoned.load(std::memory_order_relaxed)) { break; }
+      write_record(state, entry, {state.writing.text.data() + begin, entry.end - begin});
+      begin = entry.end;
+      state.queued.fetch_sub(1, std::memory_order_relaxed);
+    }
+    state.writing.clear();
+    if (flush_target > state.flushes_done) {
+      timed(state, [&] { state.inner->flush(); });
+    }
+
+    lock.lock();
+    if (flush_target > state.flushes_done) {
+      state.flushes_done = flush_target;
+      state.flushed.notify_all();
+    }
+    if (state.abandoned.load(std::memory_order_relaxed) || (state.stop && state.pending.empty())) {
+      break;
+    }
+  }
+  state.writer_exited = true;
+  state.exited.notify_all();
+}
+
+/**
+ * @brief A sink that writes to another sink from a dedicated thread and drops records while the
+ * other sink is stalled.
+ *
+ * Three parties are involved: logging threads only append to the queue (or drop), the writer
+ * thread drains the queue into the decorated sink, and a monitor thread periodically checks
+ * whether the writer is stuck in a write and reports transitions between the normal and degraded
+ * states. Keeping the checks and the callback on the monitor means that a stall is detected and
+ * reported even while the writer is blocked and no records are being logged.
+ */
+template <class Mutex>
+class stall_guard_sink : public formatting_sink<Mutex> {
+ public:
+  stall_guard_sink(std::shared_ptr<instrumented_sink> inner,
+                   std::chrono::microseconds latency_budget,
+                   stall_callback_t callback,
+                   std::size_t queue_size)
+    : state_{std::make_shared<guard_state>(std::move(inner))},
+      budget_{latency_budget},
+      callback_{callback},
+      queue_size_{queue_size}
+  {
+    state_->pending.text.reserve(queue_size_);
+    state_->writing.text.reserve(queue_size_);
+    writer_  = std::thread{write_records, state_};
+    monitor_ = std::thread{[this] { monitor(); }};
+  }
+
+  ~stall_guard_sink() override
+  {
+    bool writer_exited{};
+    {
+      std::unique_lock lock{state_->mutex};
+      state_->stop = true;
+      state_->work.notify_one();
+      // The decorated sink may be stalled indefinitely, so the writer gets at most one budget to
+      // write out the queue. Otherwise it is left to finish its current write on its own, and
+      // the records it has not written are dropped.
+      writer_exited =
+        state_->exited.wait_for(lock, budget_, [this] { return state_->writer_exited; });
+      if (!writer_exited) {
+        state_->abandoned.store(true, std::memory_order_relaxed);
+        dropped_.fetch_add(state_->queued.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+      }
+    }
+    if (writer_exited) {
+      writer_.join();
+    } else {
+      writer_.detach();
+    }
+    {
+      std::lock_guard lock{monitor_mutex_};
+      stop_monitor_ = true;
+    }
+    monitor_wake_.notify_one();
+    monitor_.join();
+  }
+
+  stall_guard_sink(stall_guard_sink const&)            = delete;
+  stall_guard_sink& operator=(stall_guard_sink const&) = delete;
+
+  std::uint64_t dropped() const noexcept override
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted) override
+  {
+    bool const always_keep = msg.level >= spdlog::level::err;
+    if (!always_keep && degraded_.load(std::memory_order_relaxed)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    bool was_empty{};
+    {
+      std::lock_guard lock{state_->mutex};
+      if (!always_keep && state_->pending.text.size() + formatted.size() > queue_size_) {
+        overflowed_.store(true, std::memory_order_relaxed);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      was_empty = state_->pending.empty();
+      state_->pending.text.insert(state_->pending.text.end(), formatted.begin(), formatted.end());
+      state_->pending.entries.push_back({msg.level, msg.time, state_->pending.text.size()});
+      state_->queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (was_empty) { state_->work.notify_one(); }
+    report_error();
+    return true;
+  }
+
+  void flush_() override
+  {
+    std::uint64_t requested{};
+    {
+      std::lock_guard lock{state_->mutex};
+      requested = ++state_->flushes_requested;
+    }
+    state_->work.notify_one();
+    // A degraded guard leaves the flush to the writer, so that flushes, including those triggered
+    // by flush_on(), do not hold up the caller while the decorated sink is stalled.
+    if (!degraded_.load(std::memory_order_relaxed)) {
+      // The sink's mutex is released while waiting, so other logging threads can keep queueing.
+      unlock_guard unlock{this->mutex_};
+      std::unique_lock lock{state_->mutex};
+      state_->flushed.wait_for(lock, budget_, [&] { return state_->flushes_done >= requested; });
+    }
+    report_error();
+  }
+
+ private:
+  /**
+   * @brief Rethrow an error of the decorated sink on the calling logging thread.
+   *
+   * The logger reports it through its error handler. The record being written is still queued.
+   */
+  void report_error()
+  {
+    std::string error;
+    {
+      std::lock_guard lock{state_->mutex};
+      if (state_->error.empty()) { return; }
+      std::swap(error, state_->error);
+    }
+    throw std::runtime_error("Stall guard: " + error);
+  }
+
+  void monitor()
+  {
+    auto const interval = std::max(budget_ / 2, std::chrono::microseconds{100});
+    std::unique_lock lock{monitor_mutex_};
+    while (!monitor_wake_.wait_for(lock, interval, [this] { return stop_monitor_; })) {
+      auto const since   = state_->in_flight_since.load(std::memory_order_relaxed);
+      auto const elapsed = std::chrono::steady_clock::now().time_since_epoch().count() - since;
+      bool const stalled = since != 0 && std::chrono::steady_clock::duration{elapsed} > budget_;
+      bool const overflowed = overflowed_.exchange(false, std::memory_order_relaxed);
+      bool const degraded   = degraded_.load(std::memory_order_relaxed);
+      if (!degraded && (stalled || overflowed)) {
+        degraded_.store(true, std::memory_order_relaxed);
+        if (callback_ != nullptr) { callback_(true); }
+      } else if (degraded && !stalled && state_->queued.load(std::memory_order_relaxed) == 0) {
+        degraded_.store(false, std::memory_order_relaxed);
+        if (callback_ != nullptr) { callback_(false); }
+      }
+    }
+  }
+
+  std::shared_ptr<guard_state> state_;
+  std::chrono::microseconds const budget_;
+  stall_callback_t const callback_;
+  std::size_t const queue_size_;
+
+  std::mutex monitor_mutex_;
+  std::condition_variable monitor_wake_;
+  bool stop_monitor_{false};
+
+  std::atomic<bool> degraded_{false};
+  std::atomic<bool> overflowed_{false};  ///< Whether the queue has been full
+  std::atomic<std::uint64_t> dropped_{0};
+
+  std::thread writer_;
+  std::thread monitor_;
+};
+
+}  // namespace
+}  // namespace detail
+
+stall_guard_sink_mt::stall_guard_sink_mt(sink_ptr const& wrapped,
+                                         std::chrono::microseconds latency_budget,
+                                         stall_callback_t callback,
+                                         std::size_t queue_size)
+  : sink{std::make_unique<detail::sink_impl>(
+      std::make_shared<detail::stall_guard_sink<std::mutex>>(
+        wrapped->impl->underlying, latency_budget, callback, queue_size))}
+{
+}
+
+}  // namespace rapids_logger
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/tsc_clock.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+// How long the initial calibration samples the counter against the system clock.
+constexpr auto initial_calibration_window = std::chrono::milliseconds{2};
+
+// How often the calibration is refreshed to follow adjustments of the system clock.
+constexpr std::int64_t recalibration_interval_ns = 1'000'000'000;
+
+/**
+ * @brief Check whether the counter ticks at a constant rate regardless of power state.
+ */
+bool has_invariant_counter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax{}, ebx{}, ecx{}, edx{};
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) { return false; }
+  return (edx & (1U << 8)) != 0;
+#elif defined(__aarch64__)
+  // The generic timer always runs at a fixed frequency.
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::int64_t system_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+/**
+ * @brief Take a (ticks, system time) sample, bracketing the system clock read with two counter
+ * reads to reduce the error introduced by a slow clock read.
+ */
+void sample(std::uint64_t& ticks, std::int64_t& ns)
+{
+  auto const before = tsc_clock::ticks();
+  ns                = system_now_ns();
+  auto const after  = tsc_clock::ticks();
+  ticks             = before + (after - before) / 2;
+}
+
+}  // namespace
+
+tsc_clock& tsc_clock::instance()
+{
+  // Never destroyed, so that loggers with static storage duration can convert span timestamps
+  // when they are destroyed.
+  static auto* clock = new tsc_clock;
+  return *clock;
+}
+
+std::uint64_t tsc_clock::ticks() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  std::uint64_t value{};
+  asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+tsc_clock::tsc_clock() : available_{has_invariant_counter()}
+{
+  if (!available_) { return; }
+  std::uint64_t start_ticks{}, end_ticks{};
+  std::int64_t start_ns{}, end_ns{};
+  sample(start_ticks, start_ns);
+  std::this_thread::sleep_for(initial_calibration_window);
+  sample(end_ticks, end_ns);
+  if (end_ticks <= start_ticks || end_ns <= start_ns) {
+    available_ = false;
+    return;
+  }
+  calibrate(end_ticks,
+            end_ns,
+            static_cast<double>(end_ns - start_ns) / static_cast<double>(end_ticks - start_ticks));
+}
+
+void tsc_clock::calibrate(std::uint64_t ticks, std::int64_t ns, double ns_per_tick) noexcept
+{
+  sample_ticks_ = ticks;
+  sample_ns_    = ns;
+
+  auto const seq = seq_.load(std::memory_order_relaxed);
+  seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  base_ticks_.store(ticks, std::memory_order_relaxed);
+  base_ns_.store(ns, std::memory_order_relaxed);
+  ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+  next_calibration_.store(
+    ticks + static_cast<std::uint64_t>(recalibration_interval_ns / ns_per_tick),
+    std::memory_order_relaxed);
+  seq_.store(seq + 2, std::memory_order_release);
+}
+
+void tsc_clock::maybe_recalibrate(std::uint64_t ticks) noexcept
+{
+  if (ticks < next_calibration_.load(std::memory_order_relaxed)) { return; }
+  // Only one thread refreshes the calibration; everyone else keeps using the current one.
+  std::unique_lock lock{calibration_mutex_, std::try_to_lock};
+  if (!lock.owns_lock() || ticks < next_calibration_.load(std::memory_order_relaxed)) { return; }
+
+  std::uint64_t now_ticks{};
+  std::int64_t now_ns{};
+  sample(now_ticks, now_ns);
+  auto ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+  if (now_ticks > sample_ticks_ && now_ns > sample_ns_) {
+    ns_per_tick =
+      static_cast<double>(now_ns - sample_ns_) / static_cast<double>(now_ticks - sample_ticks_);
+  }
+  calibrate(now_ticks, now_ns, ns_per_tick);
+}
+
+tsc_clock::time_point tsc_clock::to_time_point(std::uint64_t ticks) noexcept
+{
+  if (!available_) { return std::chrono::system_clock::now(); }
+  maybe_recalibrate(ticks);
+
+  std::uint64_t base_ticks{};
+  std::int64_t base_ns{};
+  double ns_per_tick{};
+  std::uint32_t seq{};
+  do {
+    seq         = seq_.load(std::memory_order_acquire);
+    base_ticks  = base_ticks_.load(std::memory_order_relaxed);
+    base_ns     = base_ns_.load(std::memory_order_relaxed);
+    ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1U) != 0 || seq != seq_.load(std::memory_order_relaxed));
+
+  // The difference is signed because ticks may predate a calibration published by another thread.
+  auto const delta = static_cast<std::int64_t>(ticks - base_ticks);
+  auto const ns    = base_ns + static_cast<std::int64_t>(static_cast<double>(delta) * ns_per_tick);
+  return time_point{std::chrono::duration_cast<time_point::duration>(std::chrono::nanoseconds{ns})};
+}
+
+tsc_clock::time_point tsc_clock::now() noexcept
+{
+  if (!available_) { return std::chrono::system_clock::now(); }
+  thread_local time_point last{};
+  auto const current = to_time_point(ticks());
+  if (current > last) { last = current; }
+  return last;
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,291 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/sink_impl.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+// How long the sender waits for more records before sending a partial batch.
+constexpr auto batch_interval = std::chrono::milliseconds{5};
+
+// Once this much is pending, the sender is woken up without waiting for the interval.
+constexpr std::size_t batch_threshold = 1 << 16;
+
+// Upper bound on the size of a datagram; larger batches are split at record boundaries.
+constexpr std::size_t max_datagram_size = 1 << 16;
+
+// Bounds of the exponential backoff between reconnection attempts.
+constexpr auto min_reconnect_delay = std::chrono::milliseconds{10};
+constexpr auto max_reconnect_delay = std::chrono::milliseconds{1000};
+
+// How long a sink that is being destroyed keeps trying to deliver the records it still holds.
+constexpr auto shutdown_timeout = std::chrono::milliseconds{1000};
+
+/**
+ * @brief Records buffered for sending, with the end offset of each record.
+ */
+struct batch {
+  std::vector<char> data;
+  std::vector<std::size_t> ends;
+  std::size_t sent_bytes{0};    ///< Bytes already handed to the socket
+  std::size_t sent_records{0};  ///< Records already handed to the socket
+
+  bool empty() const noexcept { return sent_bytes == data.size(); }
+  std::size_t unsent_records() const noexcept { return ends.size() - sent_records; }
+  void clear() noexcept
+  {
+    data.clear();
+    ends.clear();
+    sent_bytes   = 0;
+    sent_records = 0;
+  }
+};
+
+/**
+ * @brief A sink that forwards records to a Unix domain socket.
+ *
+ * Logging threads only append formatted records to a bounded in-memory batch. A background
+ * thread sends batches using non-blocking I/O, and (re)connects with exponential backoff
+ * whenever the socket is unavailable. If the receiver stalls or is gone and the batch is full,
+ * further records are dropped and counted, so logging threads never wait on the receiver. On
+ * destruction, the sender keeps delivering for a bounded time and drops what remains.
+ */
+template <class Mutex>
+class unix_socket_sink : public formatting_sink<Mutex> {
+ public:
+  unix_socket_sink(std::string const& path, bool datagram, std::size_t buffer_size)
+    : datagram_{datagram}, buffer_size_{buffer_size}
+  {
+    if (path.size() >= sizeof(address_.sun_path)) {
+      throw std::invalid_argument("Socket path is too long: " + path);
+    }
+    address_.sun_family = AF_UNIX;
+    std::memcpy(address_.sun_path, path.c_str(), path.size() + 1);
+    pending_.data.reserve(buffer_size_);
+    sending_.data.reserve(buffer_size_);
+    sender_ = std::thread{[this] { send_batches(); }};
+  }
+
+  ~unix_socket_sink() override
+  {
+    {
+      std::lock_guard lock{buffer_mutex_};
+      stop_ = true;
+    }
+    wake_.notify_one();
+    sender_.join();
+    disconnect();
+  }
+
+  unix_socket_sink(unix_socket_sink const&)            = delete;
+  unix_socket_sink& operator=(unix_socket_sink const&) = delete;
+
+  std::uint64_t dropped() const noexcept override
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  bool write_(const spdlog::details::log_msg&, spdlog::memory_buf_t& formatted) override
+  {
+    auto const size = formatted.size();
+    bool wake{false};
+    {
+      std::lock_guard lock{buffer_mutex_};
+      if (pending_.data.size() + size > buffer_size_ || (datagram_ && size > max_datagram_size)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      auto const before = pending_.data.size();
+      pending_.data.insert(pending_.data.end(), formatted.data(), formatted.data() + size);
+      pending_.ends.push_back(pending_.data.size());
+      wake = before < batch_threshold && pending_.data.size() >= batch_threshold;
+    }
+    if (wake) { wake_.notify_one(); }
+    return true;
+  }
+
+  /**
+   * @brief Ask the sender to send everything pending now.
+   *
+   * This does not wait for delivery, since that would block the caller on a stalled receiver.
+   */
+  void flush_() override
+  {
+    {
+      std::lock_guard lock{buffer_mutex_};
+      flush_requested_ = true;
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  void send_batches()
+  {
+    auto reconnect_delay = min_reconnect_delay;
+    auto next_attempt    = std::chrono::steady_clock::now();
+    bool stopping{false};
+    std::chrono::steady_clock::time_point deadline{};
+    while (true) {
+      {
+        std::unique_lock lock{buffer_mutex_};
+        wake_.wait_for(lock, batch_interval, [this] {
+          return stop_ || flush_requested_ || pending_.data.size() >= batch_threshold;
+        });
+        if (stop_ && !stopping) {
+          // Once stopped, what is left is delivered until the deadline without waiting for the
+          // backoff to expire, and anything still undelivered at the deadline is dropped.
+          stopping     = true;
+          deadline     = std::chrono::steady_clock::now() + shutdown_timeout;
+          next_attempt = std::chrono::steady_clock::now();
+        }
+        flush_requested_ = false;
+        // A batch that could not be fully sent is finished before the next one is started.
+        if (sending_.empty()) {
+          sending_.clear();
+          std::swap(pending_, sending_);
+        }
+        if (stopping && ((sending_.empty() && pending_.empty()) ||
+                         std::chrono::steady_clock::now() >= deadline)) {
+          dropped_.fetch_add(sending_.unsent_records() + pending_.unsent_records(),
+                             std::memory_order_relaxed);
+          return;
+        }
+      }
+      if (sending_.empty()) { continue; }
+
+      if (fd_ < 0) {
+        if (auto const now = std::chrono::steady_clock::now(); now < next_attempt) {
+          // The wait above returns at once while stopping, so wait for the next attempt here.
+          if (stopping) { std::this_thread::sleep_until(std::min(next_attempt, deadline)); }
+          continue;
+        }
+        if (!connect()) {
+          next_attempt    = std::chrono::steady_clock::now() + reconnect_delay;
+          reconnect_delay = std::min(reconnect_delay * 2, max_reconnect_delay);
+          continue;
+        }
+        reconnect_delay = min_reconnect_delay;
+      }
+      if (!send(sending_)) {
+        disconnect();
+        // A record that was only partly sent is sent again in full on the next connection, so
+        // that the receiver never sees a connection start in the middle of a record.
+        sending_.sent_bytes =
+          (sending_.sent_records == 0) ? 0 : sending_.ends[sending_.sent_records - 1];
+        next_attempt = std::chrono::steady_clock::now() + reconnect_delay;
+      }
+    }
+  }
+
+  bool connect()
+  {
+    auto const type = (datagram_ ? SOCK_DGRAM : SOCK_STREAM) | SOCK_NONBLOCK | SOCK_CLOEXEC;
+    fd_             = ::socket(AF_UNIX, type, 0);
+    if (fd_ < 0) { return false; }
+    if (::connect(fd_, reinterpret_cast<sockaddr const*>(&address_), sizeof(address_)) != 0) {
+      disconnect();
+      return false;
+    }
+    return true;
+  }
+
+  void disconnect()
+  {
+    if (fd_ >= 0) { ::close(fd_); }
+    fd_ = -1;
+  }
+
+  /**
+   * @brief Send as much of a batch as the socket accepts within one batch interval.
+   *
+   * @return false if the connection failed and must be reestablished
+   */
+  bool send(batch& b)
+  {
+    while (!b.empty()) {
+      auto const begin = b.data.data() + b.sent_bytes;
+      auto size        = b.data.size() - b.sent_bytes;
+      std::size_t records{0};
+      if (datagram_) {
+        // Pack as many whole records as fit into one datagram.
+        size = 0;
+        while (b.sent_records + records < b.ends.size() &&
+               b.ends[b.sent_records + records] - b.sent_bytes <= max_datagram_size) {
+          size = b.ends[b.sent_records + records] - b.sent_bytes;
+          ++records;
+        }
+      }
+      auto const n = ::send(fd_, begin, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (n < 0) {
+        if (errno == EINTR) { continue; }
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS) { return false; }
+        // The receiver is not keeping up; wait a little, then let new records accumulate.
+        pollfd pfd{fd_, POLLOUT, 0};
+        if (::poll(&pfd, 1, static_cast<int>(batch_interval.count())) <= 0) { return true; }
+        continue;
+      }
+      b.sent_bytes += static_cast<std::size_t>(n);
+      b.sent_records += records;
+      // A stream socket may accept only part of the data, so count the records it completed.
+      while (!datagram_ && b.sent_records < b.ends.size() &&
+             b.ends[b.sent_records] <= b.sent_bytes) {
+        ++b.sent_records;
+      }
+    }
+    return true;
+  }
+
+  bool const datagram_;
+  std::size_t const buffer_size_;
+  sockaddr_un address_{};
+  int fd_{-1};  ///< Only touched by the sender thread after construction
+
+  std::mutex buffer_mutex_;
+  std::condition_variable wake_;
+  batch pending_;  ///< Filled by logging threads
+  batch sending_;  ///< Owned by the sender thread
+  bool flush_requested_{false};
+  bool stop_{false};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::thread sender_;
+};
+
+}  // namespace
+}  // namespace detail
+
+unix_socket_sink_mt::unix_socket_sink_mt(std::string const& path,
+                                         bool datagram,
+                                         std::size_t buffer_size)
+  : sink{std::make_unique<detail::sink_impl>(
+      std::make_shared<detail::unix_socket_sink<std::mutex>>(path, datagram, buffer_size))}
+{
+}
+
+}  // namespace rapids_logger
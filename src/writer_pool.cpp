@@ -0,0 +1,476 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/writer_pool.hpp"
+
+#include "detail/context.hpp"
+#include "detail/sharded_counters.hpp"
+#include "detail/tsc_clock.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"
+#include <spdlog/details/os.h>
+#pragma GCC diagnostic pop
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rapids_logger {
+namespace detail {
+namespace {
+
+/**
+ * @brief The fixed-size part of a queued record, followed by the message and context text.
+ */
+struct record_header {
+  std::uint32_t size;  ///< Size of the record including the header, padded for alignment
+  level_enum level;
+  std::uint32_t message_size;
+  std::uint32_t context_size;
+  std::uint64_t thread_id;
+  std::int64_t time;  ///< Raw counter ticks, or system clock ns if the counter is not used
+};
+
+constexpr std::size_t record_size(std::size_t message_size, std::size_t context_size)
+{
+  auto const size = sizeof(record_header) + message_size + context_size;
+  return (size + alignof(record_header) - 1) / alignof(record_header) * alignof(record_header);
+}
+
+/**
+ * @brief Parse a Linux CPU list such as "0-15,32-47" into a CPU set.
+ */
+void parse_cpu_list(std::string const& list, cpu_set_t& cpus)
+{
+  std::istringstream stream{list};
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") { continue; }
+    auto const dash  = range.find('-');
+    auto const first = std::stoi(range.substr(0, dash));
+    auto const last  = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+      CPU_SET(cpu, &cpus);
+    }
+  }
+}
+
+/**
+ * @brief Get the CPUs of a NUMA node from sysfs.
+ */
+cpu_set_t numa_node_cpus(int node)
+{
+  std::ifstream file{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+  std::string list;
+  if (node < 0 || !std::getline(file, list)) {
+    throw std::invalid_argument("Unknown NUMA node " + std::to_string(node));
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  parse_cpu_list(list, cpus);
+  if (CPU_COUNT(&cpus) == 0) {
+    throw std::invalid_argument("NUMA node " + std::to_string(node) + " has no CPUs");
+  }
+  return cpus;
+}
+
+/**
+ * @brief Get the CPUs that a writer is pinned to, or nothing if it is not pinned.
+ */
+std::optional<cpu_set_t> writer_cpus(async_options const& options, std::size_t writer)
+{
+  if (!options.cpus.empty()) {
+    auto const cpu = options.cpus[writer % options.cpus.size()];
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      throw std::invalid_argument("Invalid CPU " + std::to_string(cpu));
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return cpus;
+  }
+  if (!options.numa_nodes.empty()) {
+    return numa_node_cpus(options.numa_nodes[writer % options.numa_nodes.size()]);
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+/**
+ * @brief A writer thread and its queue.
+ */
+class writer_pool::writer {
+ public:
+  writer(async_options const& options,
+         std::optional<cpu_set_t> cpus,
+         clock_source clock,
+         std::string const& logger_name,
+         record_writer& target)
+    : capacity_{options.queue_size},
+      overflow_{options.overflow},
+      use_ticks_{clock == clock_source::tsc && tsc_clock::instance().available()},
+      logger_name_{logger_name},
+      target_{target}
+  {
+    std::promise<int> started;
+    auto result = started.get_future();
+    thread_     = std::thread{
+      [this, cpus, started = std::move(started)]() mutable { run(cpus, started); }};
+    int error{0};
+    try {
+      error = result.get();
+    } catch (...) {
+      thread_.join();
+      throw;
+    }
+    if (error != 0) {
+      thread_.join();
+      throw std::system_error(error, std::generic_category(), "Failed pinning a log writer");
+    }
+  }
+
+  ~writer()
+  {
+    {
+      std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    work_.notify_one();
+    thread_.join();
+  }
+
+  writer(writer const&)            = delete;
+  writer& operator=(writer const&) = delete;
+
+  bool push(level_enum lvl, std::string_view message)
+  {
+    auto const time    = timestamp();
+    auto const context = current_context().view();
+    auto const size    = record_size(message.size(), context.size());
+    if (size > capacity_ || size > std::numeric_limits<std::uint32_t>::max()) {
+      if (overflow_ == overflow_policy::drop) { return false; }
+      // The record can never fit in the queue, so it is written on this thread once the records
+      // queued before it have been written.
+      wait_for_flush(request_flush());
+      spdlog::details::log_msg msg{to_time_point(time),
+                                   spdlog::source_loc{},
+                                   logger_name_,
+                                   static_cast<spdlog::level::level_enum>(lvl),
+                                   {message.data(), message.size()}};
+      target_.write_record(msg);
+      return true;
+    }
+
+    std::unique_lock lock{mutex_};
+    auto const used = [this] { return pending_.used.load(std::memory_order_relaxed); };
+    if (used() + size > capacity_) {
+      if (overflow_ == overflow_policy::drop) { return false; }
+      space_.wait(lock, [&] { return used() + size <= capacity_; });
+    }
+    bool const was_empty = used() == 0;
+    auto* out            = pending_.data.load(std::memory_order_relaxed) + used();
+    record_header const header{static_cast<std::uint32_t>(size),
+                               lvl,
+                               static_cast<std::uint32_t>(message.size()),
+                               static_cast<std::uint32_t>(context.size()),
+                               static_cast<std::uint64_t>(spdlog::details::os::thread_id()),
+                               time};
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), message.data(), message.size());
+    std::memcpy(out + sizeof(header) + message.size(), context.data(), context.size());
+    // Released for the crash handler, which reads the queue without the lock.
+    pending_.used.store(used() + size, std::memory_order_release);
+    lock.unlock();
+    if (was_empty) { work_.notify_one(); }
+    return true;
+  }
+
+  /**
+   * @brief Ask the writer to write out everything queued so far.
+   *
+   * @return The ticket to wait for
+   */
+  std::uint64_t request_flush()
+  {
+    std::lock_guard lock{mutex_};
+    auto const ticket = ++flushes_requested_;
+    work_.notify_one();
+    return ticket;
+  }
+
+  void wait_for_flush(std::uint64_t ticket)
+  {
+    std::unique_lock lock{mutex_};
+    flushed_.wait(lock, [&] { return flushes_done_ >= ticket; });
+  }
+
+  /**
+   * @brief Write the records that were queued but not yet written, from the crash handler.
+   *
+   * Records being written are followed by the pending ones, in the order they were logged. Only
+   * async-signal-safe operations are used, so records are written as their level and message,
+   * without the logger's pattern. The queue may be changing while it is read, so every record is
+   * checked to lie within its buffer.
+   */
+  void emergency_write(std::span<std::atomic<crash_flushable*> const> sinks) const noexcept
+  {
+    emergency_write(writing_, written_.load(std::memory_order_acquire), sinks);
+    emergency_write(pending_, 0, sinks);
+  }
+
+ private:
+  /**
+   * @brief A buffer of queued records.
+   *
+   * The fields are atomic so that the crash handler can read them without the lock. They always
+   * point into one of the writer's two buffers.
+   */
+  struct arena {
+    std::atomic<char*> data{nullptr};
+    std::atomic<std::size_t> used{0};
+  };
+
+  std::int64_t timestamp() const noexcept
+  {
+    // Converting counter ticks to wall time is left to the writer.
+    if (use_ticks_) { return static_cast<std::int64_t>(tsc_clock::ticks()); }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+
+  spdlog::log_clock::time_point to_time_point(std::int64_t time) const noexcept
+  {
+    if (use_ticks_) {
+      return tsc_clock::instance().to_time_point(static_cast<std::uint64_t>(time));
+    }
+    return spdlog::log_clock::time_point{
+      std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds{time})};
+  }
+
+  void run(std::optional<cpu_set_t> cpus, std::promise<int>& started)
+  {
+    if (cpus) {
+      if (auto const error = ::pthread_setaffinity_np(::pthread_self(), sizeof(*cpus), &*cpus);
+          error != 0) {
+        started.set_value(error);
+        return;
+      }
+    }
+    // Allocate the queue from the pinned thread; make_unique value-initializes it, which touches
+    // its pages so that they are placed on the local node.
+    try {
+      for (auto& buffer : buffers_) {
+        buffer = std::make_unique<char[]>(capacity_);
+      }
+      pending_.data.store(buffers_[0].get(), std::memory_order_release);
+      writing_.data.store(buffers_[1].get(), std::memory_order_release);
+    } catch (...) {
+      started.set_exception(std::current_exception());
+      return;
+    }
+    started.set_value(0);
+
+    std::unique_lock lock{mutex_};
+    while (true) {
+      work_.wait(lock, [this] {
+        return stop_ || pending_.used.load(std::memory_order_relaxed) > 0 ||
+               flushes_done_ < flushes_requested_;
+      });
+      auto const flush_target = flushes_requested_;
+      swap_arenas();
+      lock.unlock();
+      space_.notify_all();
+
+      write_records();
+
+      lock.lock();
+      if (flush_target > flushes_done_) {
+        flushes_done_ = flush_target;
+        flushed_.notify_all();
+      }
+      if (stop_ && pending_.used.load(std::memory_order_relaxed) == 0) { return; }
+    }
+  }
+
+  /**
+   * @brief Hand the pending records to the writer and give logging threads the empty buffer.
+   *
+   * Must be called with the lock held. The records are published as being written before they
+   * are removed from the pending arena, so a crash in between writes them twice rather than not
+   * at all.
+   */
+  void swap_arenas() noexcept
+  {
+    auto* const full    = pending_.data.load(std::memory_order_relaxed);
+    auto* const empty   = writing_.data.load(std::memory_order_relaxed);
+    auto const n_queued = pending_.used.load(std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    writing_.data.store(full, std::memory_order_release);
+    writing_.used.store(n_queued, std::memory_order_release);
+    pending_.used.store(0, std::memory_order_release);
+    pending_.data.store(empty, std::memory_order_release);
+  }
+
+  void write_records()
+  {
+    auto& context    = current_context();
+    auto const* data = writing_.data.load(std::memory_order_relaxed);
+    auto const used  = writing_.used.load(std::memory_order_relaxed);
+    for (std::size_t offset = 0; offset < used;) {
+      auto const* record = data + offset;
+      record_header header;
+      std::memcpy(&header, record, sizeof(header));
+      auto const* message = record + sizeof(header);
+      context.assign({message + header.message_size, header.context_size});
+      spdlog::details::log_msg msg{to_time_point(header.time),
+                                   spdlog::source_loc{},
+                                   logger_name_,
+                                   static_cast<spdlog::level::level_enum>(header.level),
+                                   {message, header.message_size}};
+      msg.thread_id = static_cast<std::size_t>(header.thread_id);
+      try {
+        target_.write_record(msg);
+      } catch (...) {
+        // The logger reports sink errors itself; anything else must not stop the writer.
+      }
+      offset += header.size;
+      written_.store(offset, std::memory_order_release);
+    }
+    context.assign({});
+    writing_.used.store(0, std::memory_order_release);
+  }
+
+  /**
+   * @brief Write the records of an arena from the given offset, from the crash handler.
+   */
+  void emergency_write(arena const& queue,
+                       std::size_t offset,
+                       std::span<std::atomic<crash_flushable*> const> sinks) const noexcept
+  {
+    auto const* data = queue.data.load(std::memory_order_acquire);
+    auto const used  = std::min(queue.used.load(std::memory_order_acquire), capacity_);
+    if (data == nullptr) { return; }
+    while (offset + sizeof(record_header) <= used) {
+      record_header header;
+      std::memcpy(&header, data + offset, sizeof(header));
+      if (header.size < sizeof(header) || header.size > used - offset ||
+          header.message_size > header.size - sizeof(header)) {
+        return;
+      }
+      auto const level = spdlog::level::to_string_view(
+        static_cast<spdlog::level::level_enum>(header.level));
+      for (auto const& slot : sinks) {
+        if (auto* target = slot.load(std::memory_order_acquire)) {
+          target->emergency_write("[", 1);
+          target->emergency_write(level.data(), level.size());
+          target->emergency_write("] ", 2);
+          target->emergency_write(data + offset + sizeof(header), header.message_size);
+          target->emergency_write("\n", 1);
+        }
+      }
+      offset += header.size;
+    }
+  }
+
+  std::size_t const capacity_;
+  overflow_policy const overflow_;
+  bool const use_ticks_;  ///< Whether records are timestamped with raw counter ticks
+  std::string const& logger_name_;
+  record_writer& target_;
+
+  std::mutex mutex_;
+  std::condition_variable work_;
+  std::condition_variable space_;
+  std::condition_variable flushed_;
+  std::unique_ptr<char[]> buffers_[2];  ///< The memory of the two arenas
+  arena pending_;                       ///< Filled by logging threads
+  arena writing_;                       ///< Owned by the writer thread
+  std::atomic<std::size_t> written_{0};  ///< Bytes of writing_ already written
+  std::uint64_t flushes_requested_{0};
+  std::uint64_t flushes_done_{0};
+  bool stop_{false};
+  std::thread thread_;
+};
+
+writer_pool::writer_pool(async_options const& options,
+                         clock_source clock,
+                         std::string const& logger_name,
+                         record_writer& target)
+{
+  if (options.writer_threads == 0) {
+    throw std::invalid_argument("A logger needs at least one writer thread");
+  }
+  if (options.queue_size < record_size(0, 0)) {
+    throw std::invalid_argument("The writer queue is too small to hold a record");
+  }
+  if (!options.cpus.empty() && !options.numa_nodes.empty()) {
+    throw std::invalid_argument("Writers can be pinned to CPUs or to NUMA nodes, but not both");
+  }
+  for (std::size_t i = 0; i < options.writer_threads; ++i) {
+    writers_.push_back(
+      std::make_unique<writer>(options, writer_cpus(options, i), clock, logger_name, target));
+  }
+}
+
+writer_pool::~writer_pool() = default;
+
+bool writer_pool::push(level_enum lvl, std::string_view message)
+{
+  return writers_[thread_shard(writers_.size())]->push(lvl, message);
+}
+
+void writer_pool::flush_calling_thread()
+{
+  auto& w = *writers_[thread_shard(writers_.size())];
+  w.wait_for_flush(w.request_flush());
+}
+
+void writer_pool::emergency_write(
+  std::span<std::atomic<crash_flushable*> const> sinks) const noexcept
+{
+  for (auto const& w : writers_) {
+    w->emergency_write(sinks);
+  }
+}
+
+void writer_pool::flush()
+{
+  std::vector<std::uint64_t> tickets;
+  tickets.reserve(writers_.size());
+  for (auto& w : writers_) {
+    tickets.push_back(w->request_flush());
+  }
+  for (std::size_t i = 0; i < writers_.size(); ++i) {
+    writers_[i]->wait_for_flush(tickets[i]);
+  }
+}
+
+}  // namespace detail
+}  // namespace rapids_logger
@@ -0,0 +1,288 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Verifies that the logging paths do not allocate once a logger has been warmed up. The test
+// replaces malloc and the global operator new so that every heap allocation made by the calling
+// thread, whether in the test, in rapids_logger or in spdlog, is counted.
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+// Only allocations made by the thread under test while counting is enabled are recorded.
+thread_local bool counting{false};
+thread_local std::size_t allocations{0};
+
+void record_allocation()
+{
+  if (counting) { ++allocations; }
+}
+
+void* counted_new(std::size_t size)
+{
+  record_allocation();
+  if (void* ptr = __libc_malloc(size == 0 ? 1 : size)) { return ptr; }
+  throw std::bad_alloc{};
+}
+
+void* counted_aligned_new(std::size_t size, std::align_val_t alignment)
+{
+  record_allocation();
+  if (void* ptr = __libc_memalign(static_cast<std::size_t>(alignment), size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+}  // namespace
+
+extern "C" {
+void* malloc(std::size_t size)
+{
+  record_allocation();
+  return __libc_malloc(size);
+}
+void* calloc(std::size_t count, std::size_t size)
+{
+  record_allocation();
+  return __libc_calloc(count, size);
+}
+void* realloc(void* ptr, std::size_t size)
+{
+  record_allocation();
+  return __libc_realloc(ptr, size);
+}
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+void* operator new(std::size_t size) { return counted_new(size); }
+void* operator new[](std::size_t size) { return counted_new(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+  record_allocation();
+  return __libc_malloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+  record_allocation();
+  return __libc_malloc(size == 0 ? 1 : size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return counted_aligned_new(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return counted_aligned_new(size, alignment);
+}
+void operator delete(void* ptr) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr) noexcept { __libc_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { __libc_free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { __libc_free(ptr); }
+
+namespace {
+
+/**
+ * @brief Count the heap allocations made by the calling thread while running a function.
+ */
+template <typename F>
+std::size_t count_allocations(F&& f)
+{
+  allocations = 0;
+  counting    = true;
+  f();
+  counting = false;
+  return allocations;
+}
+
+/**
+ * @brief A stream buffer that discards its output without ever growing.
+ */
+struct discard_buf : public std::streambuf {
+  int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+  std::streamsize xsputn(char const*, std::streamsize count) override { return count; }
+};
+
+void noop_callback(int, char const*) {}
+
+enum class sink_kind { ostream, file, null, stderr_, callback };
+
+struct AllocationTest : public ::testing::TestWithParam<sink_kind> {
+  AllocationTest() : stream{&buf}, logger_{"allocation_test", {make_sink(GetParam())}}
+  {
+    logger_.set_level(rapids_logger::level_enum::info);
+  }
+
+  ~AllocationTest() override
+  {
+    if (GetParam() == sink_kind::file) { std::filesystem::remove(filename); }
+  }
+
+  rapids_logger::sink_ptr make_sink(sink_kind kind)
+  {
+    switch (kind) {
+      case sink_kind::ostream: return std::make_shared<rapids_logger::ostream_sink_mt>(stream);
+      case sink_kind::file:
+        return std::make_shared<rapids_logger::basic_file_sink_mt>(filename, true);
+      case sink_kind::null: return std::make_shared<rapids_logger::null_sink_mt>();
+      case sink_kind::stderr_: return std::make_shared<rapids_logger::stderr_sink_mt>();
+      case sink_kind::callback:
+        return std::make_shared<rapids_logger::callback_sink_mt>(noop_callback);
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Log through a function twice, returning the allocation count of the second call.
+   *
+   * The first call warms up lazily initialized state such as the sink's reusable buffer, spdlog's
+   * cached time fields, and the stdio buffer of a file.
+   */
+  template <typename F>
+  std::size_t steady_state_allocations(F&& f)
+  {
+    f();
+    return count_allocations(f);
+  }
+
+  std::string const filename{"allocation_test_" + std::to_string(::getpid()) + ".log"};
+  discard_buf buf;
+  std::ostream stream;
+  rapids_logger::logger logger_;
+};
+
+}  // namespace
+
+TEST_P(AllocationTest, LogCString)
+{
+  EXPECT_EQ(steady_state_allocations([&] {
+              logger_.log(rapids_logger::level_enum::info,
+                          "A message that is too long for the small string optimization");
+            }),
+            0);
+}
+
+TEST_P(AllocationTest, LogStringView)
+{
+  std::string_view const msg{"A message that is too long for the small string optimization"};
+  EXPECT_EQ(
+    steady_state_allocations([&] { logger_.log(rapids_logger::level_enum::info, msg); }), 0);
+}
+
+TEST_P(AllocationTest, LogString)
+{
+  std::string const msg{"A message that is too long for the small string optimization"};
+  EXPECT_EQ(
+    steady_state_allocations([&] { logger_.log(rapids_logger::level_enum::info, msg); }), 0);
+}
+
+TEST_P(AllocationTest, LevelFunctionWithoutArguments)
+{
+  EXPECT_EQ(steady_state_allocations(
+              [&] { logger_.info("A message that is too long for the small string optimization"); }),
+            0);
+}
+
+TEST_P(AllocationTest, FormatCString)
+{
+  EXPECT_EQ(steady_state_allocations([&] {
+              logger_.info("A formatted message with an int %d and a string %s", 42, "argument");
+            }),
+            0);
+}
+
+TEST_P(AllocationTest, FormatStringArguments)
+{
+  std::string const format{"A formatted message with a string argument: %s"};
+  std::string const arg{"an argument that is too long for the small string optimization"};
+  EXPECT_EQ(steady_state_allocations([&] { logger_.warn(format, arg); }), 0);
+}
+
+TEST_P(AllocationTest, FilteredRecord)
+{
+  EXPECT_EQ(count_allocations([&] {
+              logger_.debug("A filtered message with an int %d and a string %s", 42, "argument");
+              logger_.log(rapids_logger::level_enum::trace, "A filtered message");
+            }),
+            0);
+}
+
+TEST_P(AllocationTest, LongFormattedMessage)
+{
+  // Messages longer than the formatting stack buffer need exactly one temporary allocation.
+  std::string const arg(1024, 'x');
+  EXPECT_EQ(steady_state_allocations([&] { logger_.info("%s", arg); }), 1);
+}
+
+TEST_P(AllocationTest, Context)
+{
+  logger_.set_pattern("[%&] %v");
+  EXPECT_EQ(steady_state_allocations([&] {
+              rapids_logger::context_scope query{"query", "a query id"};
+              rapids_logger::context_scope rank{"rank", 42};
+              logger_.info("A message that is too long for the small string optimization");
+            }),
+            0);
+}
+
+TEST(ManyLoggersAllocationTest, RotatingThroughLoggers)
+{
+  // A thread that logs to many loggers in turn keeps a formatter for each of them.
+  discard_buf buf;
+  std::ostream stream{&buf};
+  std::vector<std::unique_ptr<rapids_logger::logger>> loggers;
+  for (int i = 0; i < 8; ++i) {
+    std::vector<rapids_logger::sink_ptr> sinks{
+      std::make_shared<rapids_logger::ostream_sink_mt>(stream)};
+    loggers.push_back(
+      std::make_unique<rapids_logger::logger>("allocation_test_" + std::to_string(i), sinks));
+  }
+  auto const log_to_all = [&] {
+    for (auto& logger_ : loggers) {
+      logger_->info("A message that is too long for the small string optimization");
+    }
+  };
+  log_to_all();
+  EXPECT_EQ(count_allocations(log_to_all), 0);
+
+  // Destroying a logger drops its formatters without disturbing the others.
+  loggers.erase(loggers.begin());
+  log_to_all();
+  EXPECT_EQ(count_allocations(log_to_all), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllSinks,
+                         AllocationTest,
+                         ::testing::Values(sink_kind::ostream,
+                                           sink_kind::file,
+                                           sink_kind::null,
+                                           sink_kind::stderr_,
+                                           sink_kind::callback));
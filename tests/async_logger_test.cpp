@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+std::atomic<bool> blocked{false};
+std::atomic<int> writer_cpu{-1};
+
+// Blocks while `blocked` is set, and records the CPU that the writer runs on.
+void writer_callback(int, char const*)
+{
+  writer_cpu = ::sched_getcpu();
+  while (blocked.load()) {
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+}  // namespace
+
+TEST(AsyncLoggerTest, WritesRecordsInOrderPerThread)
+{
+  std::ostringstream oss;
+  rapids_logger::async_options options;
+  options.writer_threads = 4;
+  rapids_logger::logger logger_{
+    "async_test", {std::make_shared<rapids_logger::ostream_sink_mt>(oss)}, options};
+  logger_.set_pattern("%v");
+
+  constexpr int n_threads{8};
+  constexpr int n_messages{1000};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < n_messages; ++i) {
+        logger_.info("%d %d", t, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  logger_.flush();
+
+  std::map<int, int> next;
+  std::istringstream lines{oss.str()};
+  int t{}, i{};
+  int n_lines{0};
+  while (lines >> t >> i) {
+    EXPECT_EQ(i, next[t]++);
+    ++n_lines;
+  }
+  EXPECT_EQ(n_lines, n_threads * n_messages);
+  EXPECT_EQ(logger_.metrics().dropped, 0);
+}
+
+TEST(AsyncLoggerTest, KeepsTheLoggingThreadsContext)
+{
+  std::ostringstream oss;
+  rapids_logger::logger logger_{"async_test",
+                                {std::make_shared<rapids_logger::ostream_sink_mt>(oss)},
+                                rapids_logger::async_options{},
+                                rapids_logger::clock_source::tsc};
+  logger_.set_pattern("%t [%&] %v");
+  {
+    rapids_logger::context_scope request{"request", 42};
+    logger_.info("inside");
+  }
+  logger_.info("outside");
+  logger_.flush();
+
+  auto const tid = std::to_string(::syscall(SYS_gettid));
+  EXPECT_EQ(oss.str(), tid + " [request:42] inside\n" + tid + " [] outside\n");
+}
+
+TEST(AsyncLoggerTest, BufferedScopeKeepsOrder)
+{
+  std::ostringstream oss;
+  rapids_logger::async_options options;
+  options.writer_threads = 1;
+  // The writer is held up in the first record, before it reaches the ostream, so the record is
+  // not written yet when the scope replays its own.
+  auto const hold_first = [](int, char const* msg) {
+    if (std::strncmp(msg, "before", 6) == 0) { writer_callback(0, msg); }
+  };
+  rapids_logger::logger logger_{"async_test",
+                                {std::make_shared<rapids_logger::callback_sink_mt>(hold_first),
+                                 std::make_shared<rapids_logger::ostream_sink_mt>(oss)},
+                                options};
+  logger_.set_pattern("%v");
+
+  blocked = true;
+  logger_.info("before");
+  std::thread release{[] {
+    std::this_thread::sleep_for(50ms);
+    blocked = false;
+  }};
+  {
+    rapids_logger::buffered_scope scope{logger_};
+    logger_.debug("kept");
+    scope.fail();
+  }
+  logger_.info("after");
+  release.join();
+  logger_.flush();
+  EXPECT_EQ(oss.str(), "before\nkept\nafter\n");
+}
+
+TEST(AsyncLoggerTest, DropsWhenFull)
+{
+  rapids_logger::async_options options;
+  options.queue_size = 4096;
+  options.overflow   = rapids_logger::overflow_policy::drop;
+  rapids_logger::logger logger_{
+    "async_test", {std::make_shared<rapids_logger::callback_sink_mt>(writer_callback)}, options};
+
+  blocked = true;
+  constexpr int n_messages{10000};
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("message %d", i);
+  }
+  auto const metrics = logger_.metrics();
+  EXPECT_GT(metrics.dropped, 0);
+  EXPECT_LT(metrics.dropped, n_messages);
+  // Dropped records are not counted as logged.
+  auto const info = static_cast<std::size_t>(rapids_logger::level_enum::info);
+  EXPECT_EQ(metrics.messages[info] + metrics.dropped, n_messages);
+  blocked = false;
+  logger_.flush();
+}
+
+TEST(AsyncLoggerTest, WritesRecordsLargerThanTheQueue)
+{
+  std::ostringstream oss;
+  rapids_logger::async_options options;
+  options.queue_size = 256;
+  rapids_logger::logger logger_{
+    "async_test", {std::make_shared<rapids_logger::ostream_sink_mt>(oss)}, options};
+  logger_.set_pattern("%v");
+
+  std::string const large(1000, 'x');
+  logger_.info("before");
+  logger_.info(large);
+  logger_.info("after");
+  logger_.flush();
+  EXPECT_EQ(oss.str(), "before\n" + large + "\nafter\n");
+  EXPECT_EQ(logger_.metrics().dropped, 0);
+}
+
+TEST(AsyncLoggerTest, PinsWriters)
+{
+  cpu_set_t allowed;
+  ASSERT_EQ(::sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  int cpu{0};
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+
+  rapids_logger::async_options options;
+  options.cpus = {cpu};
+  rapids_logger::logger logger_{
+    "async_test", {std::make_shared<rapids_logger::callback_sink_mt>(writer_callback)}, options};
+  logger_.info("pinned");
+  logger_.flush();
+  EXPECT_EQ(writer_cpu.load(), cpu);
+}
+
+TEST(AsyncLoggerTest, PinsWritersToNumaNodes)
+{
+  if (!std::filesystem::exists("/sys/devices/system/node/node0/cpulist")) {
+    GTEST_SKIP() << "NUMA topology is not available";
+  }
+  // The cpulist is a comma-separated list of CPUs and ranges of CPUs, e.g. "0-3,8".
+  std::ifstream cpulist{"/sys/devices/system/node/node0/cpulist"};
+  std::set<int> node_cpus;
+  std::string range;
+  while (std::getline(cpulist, range, ',')) {
+    auto const dash  = range.find('-');
+    auto const first = std::stoi(range.substr(0, dash));
+    auto const last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      node_cpus.insert(cpu);
+    }
+  }
+
+  rapids_logger::async_options options;
+  options.writer_threads = 2;
+  options.numa_nodes     = {0};
+  rapids_logger::logger logger_{
+    "async_test", {std::make_shared<rapids_logger::callback_sink_mt>(writer_callback)}, options};
+  writer_cpu = -1;
+  logger_.info("pinned");
+  logger_.flush();
+  EXPECT_EQ(node_cpus.count(writer_cpu.load()), 1) << "writer ran on CPU " << writer_cpu.load();
+}
+
+TEST(AsyncLoggerTest, CrashHandlerWritesQueuedRecords)
+{
+  auto const filename = "async_crash_test_" + std::to_string(::getpid()) + ".log";
+  auto const crash    = [&] {
+    rapids_logger::install_crash_handler();
+    rapids_logger::logger logger_{
+      "async_test",
+      {std::make_shared<rapids_logger::basic_file_sink_mt>(filename, true),
+       std::make_shared<rapids_logger::callback_sink_mt>(writer_callback)},
+      rapids_logger::async_options{}};
+    logger_.set_pattern("%v");
+    logger_.flush_on_crash();
+
+    // The writer gets stuck in the second sink after the first record, so the rest stay queued.
+    blocked = true;
+    logger_.info("written");
+    while (writer_cpu.load() < 0) {
+      std::this_thread::sleep_for(1ms);
+    }
+    logger_.info("queued %d", 1);
+    logger_.warn("queued %d", 2);
+    std::raise(SIGSEGV);
+  };
+  writer_cpu = -1;
+  EXPECT_EXIT(crash(), ::testing::KilledBySignal(SIGSEGV), "");
+  std::ifstream file{filename};
+  std::string const contents{std::istreambuf_iterator<char>{file},
+                             std::istreambuf_iterator<char>{}};
+  // The record the writer was in the middle of is written again, rather than risking its loss.
+  EXPECT_EQ(contents, "written\n[info] written\n[info] queued 1\n[warning] queued 2\n");
+  std::filesystem::remove(filename);
+}
+
+TEST(AsyncLoggerTest, InvalidOptions)
+{
+  auto const make_logger = [](rapids_logger::async_options const& options) {
+    rapids_logger::logger logger_{
+      "async_test", {std::make_shared<rapids_logger::null_sink_mt>()}, options};
+  };
+  rapids_logger::async_options no_writers;
+  no_writers.writer_threads = 0;
+  EXPECT_THROW(make_logger(no_writers), std::invalid_argument);
+
+  rapids_logger::async_options unknown_node;
+  unknown_node.numa_nodes = {1 << 20};
+  EXPECT_THROW(make_logger(unknown_node), std::invalid_argument);
+
+  rapids_logger::async_options both;
+  both.cpus       = {0};
+  both.numa_nodes = {0};
+  EXPECT_THROW(make_logger(both), std::invalid_argument);
+}
@@ -7,10 +7,18 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 struct LoggerTest : public ::testing::Test {
   LoggerTest()
@@ -165,3 +173,515 @@ TEST_F(LoggerTest, LogLevelSetter)
     EXPECT_EQ(this->sink_content(), "");
   }
 }
+
+TEST(ClockTest, TscClockTimestamps)
+{
+  std::ostringstream oss;
+  rapids_logger::logger logger_{"tsc_test",
+                                {std::make_shared<rapids_logger::ostream_sink_mt>(oss)},
+                                rapids_logger::clock_source::tsc};
+  EXPECT_EQ(logger_.clock(), rapids_logger::clock_source::tsc);
+  // Seconds since the epoch followed by the nanosecond fraction.
+  logger_.set_pattern("%E%F");
+
+  auto const before = std::chrono::system_clock::now();
+  constexpr int n_messages{1000};
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("message");
+  }
+  auto const after = std::chrono::system_clock::now();
+
+  std::istringstream lines{oss.str()};
+  std::string line;
+  long long previous{0};
+  int count{0};
+  while (std::getline(lines, line)) {
+    auto const ns = std::stoll(line);
+    EXPECT_GE(ns, previous);
+    previous = ns;
+    ++count;
+  }
+  EXPECT_EQ(count, n_messages);
+
+  // The calibrated clock should agree with the system clock to well within a second.
+  auto const to_ns = [](auto tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+  };
+  EXPECT_GT(previous, to_ns(before) - 1'000'000'000LL);
+  EXPECT_LT(previous, to_ns(after) + 1'000'000'000LL);
+}
+
+TEST_F(LoggerTest, Metrics)
+{
+  std::ostringstream oss2;
+  logger_.sinks().push_back(std::make_shared<rapids_logger::ostream_sink_mt>(oss2));
+  logger_.set_pattern("%v");
+
+  logger_.info("info");
+  logger_.warn("warn %d", 1);
+  logger_.debug("debug");
+  logger_.trace("trace %d", 2);
+  logger_.flush();
+
+  auto const metrics = logger_.metrics();
+  EXPECT_EQ(metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::info)], 1);
+  EXPECT_EQ(metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::warn)], 1);
+  EXPECT_EQ(metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::debug)], 0);
+  EXPECT_EQ(metrics.filtered, 2);
+  EXPECT_EQ(metrics.dropped, 0);
+  ASSERT_EQ(metrics.sinks.size(), 2);
+  for (auto const& sink : metrics.sinks) {
+    EXPECT_EQ(sink.messages, 2);
+    EXPECT_EQ(sink.bytes, std::string{"info\nwarn 1\n"}.size());
+    EXPECT_EQ(sink.flushes, 1);
+    EXPECT_EQ(sink.drops, 0);
+    std::uint64_t timed_writes{0};
+    for (auto count : sink.latency_histogram) {
+      timed_writes += count;
+    }
+    EXPECT_EQ(timed_writes, 2);
+  }
+}
+
+TEST_F(LoggerTest, MetricsFromManyThreads)
+{
+  constexpr int n_threads{4};
+  constexpr int n_messages{1000};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.emplace_back([this] {
+      for (int i = 0; i < n_messages; ++i) {
+        logger_.info("info");
+        logger_.debug("debug");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto const metrics = logger_.metrics();
+  EXPECT_EQ(metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::info)],
+            n_threads * n_messages);
+  EXPECT_EQ(metrics.filtered, n_threads * n_messages);
+  EXPECT_EQ(metrics.sinks.at(0).messages, n_threads * n_messages);
+}
+
+TEST_F(LoggerTest, SinkLevel)
+{
+  std::ostringstream oss2;
+  auto sink2 = std::make_shared<rapids_logger::ostream_sink_mt>(oss2);
+  EXPECT_EQ(sink2->level(), rapids_logger::level_enum::trace);
+  sink2->set_level(rapids_logger::level_enum::warn);
+  logger_.sinks().push_back(sink2);
+
+  logger_.info("info");
+  logger_.warn("warn");
+  EXPECT_EQ(this->sink_content(), "info\nwarn\n");
+  EXPECT_EQ(oss2.str(), "warn\n");
+  EXPECT_EQ(sink2->metrics().messages, 1);
+}
+
+TEST_F(LoggerTest, SharedFormatting)
+{
+  // Sinks added after the pattern is set still follow the logger's pattern.
+  std::ostringstream oss2;
+  std::ostringstream oss3;
+  logger_.set_pattern("[%l] %v");
+  logger_.sinks().push_back(std::make_shared<rapids_logger::ostream_sink_mt>(oss2));
+  logger_.sinks().push_back(std::make_shared<rapids_logger::ostream_sink_mt>(oss3));
+  logger_.sinks().push_back(std::make_shared<rapids_logger::callback_sink_mt>(example_callback));
+
+  logger_.warn("message %d", 1);
+  EXPECT_EQ(this->sink_content(), "[warning] message 1\n");
+  EXPECT_EQ(oss2.str(), "[warning] message 1\n");
+  EXPECT_EQ(oss3.str(), "[warning] message 1\n");
+  EXPECT_EQ(logged, "[warning] message 1\n");
+}
+
+struct CrashHandlerTest : public ::testing::Test {
+  ~CrashHandlerTest() override { std::filesystem::remove(filename); }
+
+  /**
+   * @brief Log to a buffered file sink and crash with the given signal.
+   */
+  void log_and_crash(int sig, bool flush_on_crash)
+  {
+    rapids_logger::install_crash_handler();
+    rapids_logger::logger logger_{"crash_test", filename};
+    logger_.set_pattern("%v");
+    logger_.flush_on_crash(flush_on_crash);
+    logger_.info("before the crash");
+    logger_.error("last words");
+    std::raise(sig);
+  }
+
+  std::string contents()
+  {
+    std::ifstream file{filename};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  }
+
+  std::string const filename{"crash_test_" + std::to_string(::getpid()) + ".log"};
+};
+
+TEST_F(CrashHandlerTest, FlushesRegisteredLoggers)
+{
+  for (int sig : {SIGSEGV, SIGABRT, SIGBUS}) {
+    // The handler re-raises the signal, so the process still dies from it.
+    EXPECT_EXIT(log_and_crash(sig, true), ::testing::KilledBySignal(sig), "");
+    EXPECT_EQ(contents(), "before the crash\nlast words\n");
+  }
+}
+
+TEST_F(CrashHandlerTest, FlushesSinksAddedAfterRegistration)
+{
+  auto const crash = [this] {
+    rapids_logger::install_crash_handler();
+    std::ostringstream oss;
+    rapids_logger::logger logger_{"crash_test", oss};
+    logger_.flush_on_crash();
+    logger_.sinks().push_back(std::make_shared<rapids_logger::basic_file_sink_mt>(filename));
+    logger_.set_pattern("%v");
+    logger_.info("added later");
+    std::raise(SIGSEGV);
+  };
+  EXPECT_EXIT(crash(), ::testing::KilledBySignal(SIGSEGV), "");
+  EXPECT_EQ(contents(), "added later\n");
+}
+
+namespace {
+
+volatile bool keep_recursing{true};
+
+// Recurses until the stack overflows; the frame's array keeps the recursion from being optimized
+// into a loop.
+int overflow_stack(int depth)
+{
+  volatile char frame[1024];
+  frame[0] = static_cast<char>(depth);
+  if (!keep_recursing) { return frame[0]; }
+  return overflow_stack(depth + 1) + frame[0];
+}
+
+}  // namespace
+
+TEST_F(CrashHandlerTest, FlushesOnStackOverflow)
+{
+  auto const crash = [this] {
+    rapids_logger::install_crash_handler();
+    rapids_logger::logger logger_{"crash_test", filename};
+    logger_.set_pattern("%v");
+    logger_.flush_on_crash();
+    std::thread{[&] {
+      logger_.info("before the overflow");
+      overflow_stack(0);
+    }}.join();
+  };
+  EXPECT_EXIT(crash(), ::testing::KilledBySignal(SIGSEGV), "");
+  EXPECT_EQ(contents(), "before the overflow\n");
+}
+
+TEST_F(CrashHandlerTest, SkipsUnregisteredLoggers)
+{
+  // Without the crash handler's help, buffered records are lost.
+  EXPECT_EXIT(log_and_crash(SIGSEGV, false), ::testing::KilledBySignal(SIGSEGV), "");
+  EXPECT_EQ(contents(), "");
+}
+
+TEST_F(LoggerTest, Context)
+{
+  logger_.set_pattern("[%&] %v");
+  logger_.info("no context");
+  {
+    rapids_logger::context_scope query{"query", "q7"};
+    rapids_logger::context_scope rank{"rank", 3};
+    logger_.info("both");
+    {
+      rapids_logger::context_scope stream{"stream", -1};
+      logger_.info("nested");
+    }
+    logger_.info("popped");
+  }
+  logger_.info("cleared");
+  EXPECT_EQ(this->sink_content(),
+            "[] no context\n"
+            "[query:q7 rank:3] both\n"
+            "[query:q7 rank:3 stream:-1] nested\n"
+            "[query:q7 rank:3] popped\n"
+            "[] cleared\n");
+}
+
+TEST_F(LoggerTest, ContextIsPerThread)
+{
+  logger_.set_pattern("[%&] %v");
+  rapids_logger::context_scope main_scope{"thread", "main"};
+  std::thread{[&] {
+    rapids_logger::context_scope worker_scope{"thread", "worker"};
+    logger_.info("from worker");
+  }}.join();
+  logger_.info("from main");
+  EXPECT_EQ(this->sink_content(), "[thread:worker] from worker\n[thread:main] from main\n");
+}
+
+TEST_F(LoggerTest, ContextOverflow)
+{
+  logger_.set_pattern("[%&] %v");
+  rapids_logger::context_scope fits{"key", "value"};
+  {
+    // Fields that do not fit are omitted without disturbing the fields that do.
+    rapids_logger::context_scope too_long{"long", std::string(300, 'x')};
+    logger_.info("overflow");
+  }
+  logger_.info("after");
+  EXPECT_EQ(this->sink_content(), "[key:value] overflow\n[key:value] after\n");
+}
+
+TEST_F(LoggerTest, BufferedScopeDiscardsOnSuccess)
+{
+  {
+    rapids_logger::buffered_scope scope{logger_};
+    logger_.debug("debug %d", 1);
+    logger_.info("info");
+    logger_.trace("trace");
+  }
+  logger_.debug("after");
+  EXPECT_EQ(this->sink_content(), "info\n");
+  EXPECT_EQ(logger_.metrics().filtered, 3);
+}
+
+TEST_F(LoggerTest, BufferedScopeWritesOnFailure)
+{
+  logger_.set_pattern("%l [%&] %v");
+  {
+    rapids_logger::buffered_scope scope{logger_};
+    rapids_logger::context_scope request{"request", 7};
+    logger_.debug("debug %d", 1);
+    logger_.info("info");
+    logger_.trace("trace");
+    scope.fail();
+    EXPECT_TRUE(scope.failed());
+  }
+  // Kept records are written in order, with the context they were logged with, after the
+  // records that passed the level.
+  EXPECT_EQ(this->sink_content(),
+            "info [request:7] info\ndebug [request:7] debug 1\ntrace [request:7] trace\n");
+  auto const metrics = logger_.metrics();
+  EXPECT_EQ(metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::debug)], 1);
+  EXPECT_EQ(metrics.filtered, 0);
+}
+
+TEST_F(LoggerTest, BufferedScopeFailsOnError)
+{
+  {
+    rapids_logger::buffered_scope scope{logger_};
+    logger_.debug("debug");
+    logger_.error("error");
+    EXPECT_TRUE(scope.failed());
+  }
+  EXPECT_EQ(this->sink_content(), "error\ndebug\n");
+}
+
+TEST_F(LoggerTest, BufferedScopeNesting)
+{
+  {
+    rapids_logger::buffered_scope outer{logger_};
+    logger_.debug("outer");
+    {
+      rapids_logger::buffered_scope inner{logger_};
+      logger_.debug("inner success");
+    }
+    {
+      rapids_logger::buffered_scope inner{logger_};
+      logger_.debug("inner failure");
+      inner.fail();
+    }
+    // Only the innermost scope keeps records, so failing the outer scope only writes its own.
+    outer.fail();
+  }
+  EXPECT_EQ(this->sink_content(), "inner failure\nouter\n");
+  EXPECT_EQ(logger_.metrics().filtered, 1);
+
+  // An error fails the enclosing scopes as well, unlike fail().
+  {
+    rapids_logger::buffered_scope outer{logger_};
+    logger_.debug("outer");
+    {
+      rapids_logger::buffered_scope inner{logger_};
+      logger_.error("error");
+    }
+    EXPECT_TRUE(outer.failed());
+  }
+  EXPECT_EQ(this->sink_content(), "inner failure\nouter\nerror\nouter\n");
+  EXPECT_EQ(logger_.metrics().filtered, 1);
+}
+
+TEST_F(LoggerTest, BufferedScopeOverflow)
+{
+  {
+    rapids_logger::buffered_scope scope{logger_, 256};
+    for (int i = 0; i < 100; ++i) {
+      logger_.debug("debug %d", i);
+    }
+    scope.fail();
+  }
+  auto const metrics = logger_.metrics();
+  auto const written = metrics.messages[static_cast<std::size_t>(rapids_logger::level_enum::debug)];
+  EXPECT_GT(written, 0);
+  EXPECT_EQ(written + metrics.dropped, 100);
+  EXPECT_THAT(this->sink_content(), ::testing::StartsWith("debug 0\ndebug 1\n"));
+}
+
+TEST_F(LoggerTest, BufferedScopeOtherLogger)
+{
+  std::ostringstream oss2;
+  rapids_logger::logger other{"other", {std::make_shared<rapids_logger::ostream_sink_mt>(oss2)}};
+  {
+    rapids_logger::buffered_scope scope{logger_};
+    other.debug("other");
+    scope.fail();
+  }
+  EXPECT_EQ(oss2.str(), "");
+  EXPECT_EQ(other.metrics().filtered, 1);
+}
+
+TEST(FileSinkTest, FilenamePlaceholders)
+{
+  ::setenv("RAPIDS_LOGGER_RANK", "7", 1);
+  char host[256]{};
+  ::gethostname(host, sizeof(host) - 1);
+  auto const expected =
+    "placeholder_test." + std::string{host} + ".7." + std::to_string(::getpid()) + ".{other}.log";
+  {
+    rapids_logger::logger logger_{"placeholder_test",
+                                  "placeholder_test.{hostname}.{rank}.{pid}.{other}.log"};
+    logger_.info("hello");
+  }
+  ::unsetenv("RAPIDS_LOGGER_RANK");
+  EXPECT_TRUE(std::filesystem::exists(expected));
+  std::filesystem::remove(expected);
+}
+
+TEST(FileSinkTest, BufferSize)
+{
+  auto const path = "buffer_test." + std::to_string(::getpid()) + ".log";
+  auto const file_size = [&] { return std::filesystem::file_size(path); };
+  std::string const record(99, 'x');
+
+  // By default records are written once a block's worth has been buffered, as with stdio.
+  {
+    rapids_logger::logger logger_{
+      "buffer_test", {std::make_shared<rapids_logger::basic_file_sink_mt>(path, true)}};
+    logger_.set_pattern("%v");
+    for (int i = 0; i < 200; ++i) {
+      logger_.info(record);
+    }
+    EXPECT_GT(file_size(), 0);
+  }
+  // A larger buffer keeps them until it fills up or the logger is flushed.
+  {
+    rapids_logger::logger logger_{
+      "buffer_test", {std::make_shared<rapids_logger::basic_file_sink_mt>(path, true, 1 << 20)}};
+    logger_.set_pattern("%v");
+    for (int i = 0; i < 200; ++i) {
+      logger_.info(record);
+    }
+    EXPECT_EQ(file_size(), 0);
+    logger_.flush();
+    EXPECT_EQ(file_size(), 200 * (record.size() + 1));
+  }
+  std::filesystem::remove(path);
+}
+
+namespace {
+
+std::string read_file(std::string const& path)
+{
+  std::ifstream file{path};
+  return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+std::size_t count_occurrences(std::string const& text, std::string const& pattern)
+{
+  std::size_t count{0};
+  for (auto pos = text.find(pattern); pos != std::string::npos;
+       pos      = text.find(pattern, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(TraceTest, ChromeTraceSink)
+{
+  auto const path = "trace_test." + std::to_string(::getpid()) + ".json";
+  {
+    rapids_logger::logger logger_{"trace_test",
+                                  {std::make_shared<rapids_logger::chrome_trace_sink_mt>(path)}};
+    logger_.set_pattern("%v");
+    {
+      rapids_logger::span_scope outer{logger_, rapids_logger::level_enum::info, "outer"};
+      rapids_logger::span_scope inner{logger_, rapids_logger::level_enum::info, "inner \"quoted\""};
+      rapids_logger::span_scope skipped{logger_, rapids_logger::level_enum::debug, "skipped"};
+      logger_.info("message");
+    }
+    std::thread{[&] {
+      rapids_logger::span_scope span{logger_, rapids_logger::level_enum::warn, "other thread"};
+    }}.join();
+    logger_.flush();
+    // Spans recorded after the last flush are written when the logger is destroyed.
+    rapids_logger::span_scope last{logger_, rapids_logger::level_enum::info, "last"};
+  }
+
+  auto const trace = read_file(path);
+  std::filesystem::remove(path);
+  EXPECT_EQ(trace.substr(0, 2), "[\n");
+  EXPECT_EQ(trace.substr(trace.size() - 3), "\n]\n");
+  EXPECT_EQ(count_occurrences(trace, "\"ph\":\"X\""), 4);
+  EXPECT_EQ(count_occurrences(trace, "\"ph\":\"i\""), 1);
+  EXPECT_NE(trace.find("{\"name\":\"outer\",\"cat\":\"trace_test\",\"ph\":\"X\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"inner \\\"quoted\\\"\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"other thread\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"last\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"message\""), std::string::npos);
+  EXPECT_EQ(trace.find("skipped"), std::string::npos);
+}
+
+TEST(TraceTest, SpansAreWrittenOnFlushOn)
+{
+  auto const path = "trace_test." + std::to_string(::getpid()) + ".json";
+  {
+    rapids_logger::logger logger_{"trace_test",
+                                  {std::make_shared<rapids_logger::chrome_trace_sink_mt>(path)}};
+    logger_.flush_on(rapids_logger::level_enum::warn);
+    {
+      rapids_logger::span_scope span{logger_, rapids_logger::level_enum::info, "span"};
+    }
+    logger_.info("not flushed");
+    EXPECT_EQ(read_file(path), "");
+    logger_.warn("flushed");
+    auto const trace = read_file(path);
+    EXPECT_NE(trace.find("\"name\":\"span\""), std::string::npos);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(TraceTest, SpansAreDroppedWhenTheBufferIsFull)
+{
+  rapids_logger::logger logger_{"trace_test", {std::make_shared<rapids_logger::null_sink_mt>()}};
+  constexpr int n_spans{10000};
+  for (int i = 0; i < n_spans; ++i) {
+    rapids_logger::span_scope span{logger_, rapids_logger::level_enum::info, "span"};
+  }
+  logger_.flush();
+  auto const dropped = logger_.metrics().dropped;
+  EXPECT_GT(dropped, 0);
+  EXPECT_LT(dropped, n_spans);
+
+  // Flushing makes room for more spans.
+  rapids_logger::span_scope span{logger_, rapids_logger::level_enum::info, "span"};
+  logger_.flush();
+  EXPECT_EQ(logger_.metrics().dropped, dropped);
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.h>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+extern "C" int log_from_c(char const** message);
+
+TEST(CApiTest, FromC)
+{
+  char const* message{nullptr};
+  EXPECT_EQ(log_from_c(&message), 1);
+  EXPECT_STREQ(message, "from C\n");
+}
+
+TEST(CApiTest, Levels)
+{
+  auto* handle = rapids_logger_create("levels", 6);
+  ASSERT_NE(handle, nullptr);
+  // The default level matches the C++ logger's.
+  EXPECT_FALSE(RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_DEBUG));
+  EXPECT_TRUE(RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_INFO));
+
+  rapids_logger_set_level(handle, RAPIDS_LOGGER_LOG_LEVEL_TRACE);
+  EXPECT_TRUE(RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_TRACE));
+  EXPECT_EQ(rapids_logger_should_log(handle, RAPIDS_LOGGER_LOG_LEVEL_TRACE), 1);
+
+  rapids_logger_set_level(handle, RAPIDS_LOGGER_LOG_LEVEL_OFF);
+  EXPECT_FALSE(RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_CRITICAL));
+  EXPECT_EQ(rapids_logger_should_log(handle, RAPIDS_LOGGER_LOG_LEVEL_CRITICAL), 0);
+
+  // Invalid levels are ignored.
+  rapids_logger_set_level(handle, 42);
+  EXPECT_EQ(handle->level, RAPIDS_LOGGER_LOG_LEVEL_OFF);
+  rapids_logger_destroy(handle);
+}
+
+TEST(CApiTest, FileSink)
+{
+  std::string const filename{"c_api_test_" + std::to_string(::getpid()) + ".log"};
+  auto* handle = rapids_logger_create("file", 4);
+  ASSERT_NE(handle, nullptr);
+  EXPECT_EQ(rapids_logger_add_file_sink(handle, filename.data(), filename.size(), 1), 0);
+  EXPECT_EQ(rapids_logger_add_null_sink(handle), 0);
+  EXPECT_EQ(rapids_logger_set_pattern(handle, "[%l] %v", 7), 0);
+  rapids_logger_log(handle, RAPIDS_LOGGER_LOG_LEVEL_WARN, "hello", 5);
+  rapids_logger_destroy(handle);
+
+  std::ifstream file{filename};
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}),
+            "[warning] hello\n");
+  std::filesystem::remove(filename);
+}
+
+namespace {
+int flushes{0};
+void ignore_record(int, char const*) {}
+void count_flush() { ++flushes; }
+}  // namespace
+
+TEST(CApiTest, DestroyFlushes)
+{
+  auto* handle = rapids_logger_create("destroy", 7);
+  ASSERT_NE(handle, nullptr);
+  EXPECT_EQ(rapids_logger_add_callback_sink(handle, ignore_record, count_flush), 0);
+  rapids_logger_log(handle, RAPIDS_LOGGER_LOG_LEVEL_INFO, "hello", 5);
+  flushes = 0;
+  rapids_logger_destroy(handle);
+  EXPECT_EQ(flushes, 1);
+}
+
+TEST(CApiTest, Errors)
+{
+  auto* handle = rapids_logger_create("errors", 6);
+  ASSERT_NE(handle, nullptr);
+  // Failures are reported as status codes rather than exceptions.
+  std::string const filename{"/dev/null/file.log"};
+  EXPECT_NE(rapids_logger_add_file_sink(handle, filename.data(), filename.size(), 1), 0);
+  rapids_logger_destroy(handle);
+  rapids_logger_destroy(nullptr);
+}
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Exercises the C API from a C translation unit, ensuring that the header is valid C.
+
+#include <rapids_logger/logger.h>
+
+#include <string.h>
+
+static char last_message[256];
+static int n_messages;
+
+static void record_message(int level, char const* message)
+{
+  (void)level;
+  strncpy(last_message, message, sizeof(last_message) - 1);
+  ++n_messages;
+}
+
+int log_from_c(char const** message)
+{
+  static char const name[] = "c_logger";
+  static char const text[] = "from C, not NUL-terminated";
+  rapids_logger_handle* handle;
+
+  handle = rapids_logger_create(name, strlen(name));
+  if (handle == NULL) { return -1; }
+  if (rapids_logger_add_callback_sink(handle, record_message, NULL) != 0) { return -1; }
+  if (rapids_logger_set_pattern(handle, "%v", 2) != 0) { return -1; }
+  rapids_logger_set_level(handle, RAPIDS_LOGGER_LOG_LEVEL_WARN);
+
+  n_messages = 0;
+  if (RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_INFO)) {
+    rapids_logger_log(handle, RAPIDS_LOGGER_LOG_LEVEL_INFO, "filtered", 8);
+  }
+  if (RAPIDS_LOGGER_SHOULD_LOG(handle, RAPIDS_LOGGER_LOG_LEVEL_ERROR)) {
+    // Only the first 6 bytes are logged.
+    rapids_logger_log(handle, RAPIDS_LOGGER_LOG_LEVEL_ERROR, text, 6);
+  }
+  rapids_logger_flush(handle);
+  rapids_logger_destroy(handle);
+
+  *message = last_message;
+  return n_messages;
+}
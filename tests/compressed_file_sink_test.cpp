@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+struct CompressedFileSinkTest : public ::testing::Test {
+  ~CompressedFileSinkTest() override { std::filesystem::remove(filename); }
+
+  /**
+   * @brief Make a logger writing to a compressed file, skipping the test if zlib is unavailable.
+   */
+  std::unique_ptr<rapids_logger::logger> make_logger(bool truncate = true)
+  {
+    try {
+      auto logger_ = std::make_unique<rapids_logger::logger>(
+        "compressed_test",
+        std::vector<rapids_logger::sink_ptr>{
+          std::make_shared<rapids_logger::compressed_file_sink_mt>(filename, truncate)});
+      logger_->set_pattern("%v");
+      return logger_;
+    } catch (std::runtime_error const&) {
+      return nullptr;
+    }
+  }
+
+  /**
+   * @brief Decompress as much of the file as is readable.
+   */
+  std::string decompress()
+  {
+    std::string result;
+    auto file = gzopen(filename.c_str(), "rb");
+    if (file == nullptr) { return result; }
+    char buf[4096];
+    int n{};
+    while ((n = gzread(file, buf, sizeof(buf))) > 0) {
+      result.append(buf, static_cast<std::size_t>(n));
+    }
+    gzclose(file);
+    return result;
+  }
+
+  std::string const filename{"compressed_test_" + std::to_string(::getpid()) + ".log.gz"};
+};
+
+TEST_F(CompressedFileSinkTest, RoundTrip)
+{
+  auto logger_ = make_logger();
+  if (!logger_) { GTEST_SKIP() << "rapids_logger was built without zlib"; }
+
+  std::string expected;
+  for (int i = 0; i < 10000; ++i) {
+    logger_->info("message %d", i);
+    expected += "message " + std::to_string(i) + "\n";
+  }
+  logger_.reset();
+
+  EXPECT_EQ(decompress(), expected);
+  // Repetitive log text should compress well.
+  EXPECT_LT(std::filesystem::file_size(filename), expected.size() / 4);
+}
+
+TEST_F(CompressedFileSinkTest, FlushIsReadable)
+{
+  auto logger_ = make_logger();
+  if (!logger_) { GTEST_SKIP() << "rapids_logger was built without zlib"; }
+
+  logger_->info("first");
+  logger_->info("second");
+  logger_->flush();
+  // The stream has not been finished yet, but everything up to the flush can be decompressed.
+  EXPECT_EQ(decompress(), "first\nsecond\n");
+
+  logger_->info("third");
+  logger_.reset();
+  EXPECT_EQ(decompress(), "first\nsecond\nthird\n");
+}
+
+TEST_F(CompressedFileSinkTest, Append)
+{
+  auto logger_ = make_logger();
+  if (!logger_) { GTEST_SKIP() << "rapids_logger was built without zlib"; }
+  logger_->info("first");
+  logger_.reset();
+
+  logger_ = make_logger(false);
+  logger_->info("second");
+  logger_.reset();
+
+  EXPECT_EQ(decompress(), "first\nsecond\n");
+}
+
+TEST_F(CompressedFileSinkTest, ReportsWriteErrors)
+{
+  if (!make_logger()) { GTEST_SKIP() << "rapids_logger was built without zlib"; }
+  if (!std::filesystem::exists("/dev/full")) { GTEST_SKIP() << "/dev/full is not available"; }
+  // Every write to /dev/full fails as if the disk were full.
+  rapids_logger::logger logger_{
+    "compressed_test", {std::make_shared<rapids_logger::compressed_file_sink_mt>("/dev/full")}};
+
+  ::testing::internal::CaptureStderr();
+  logger_.info("lost");
+  logger_.flush();
+  auto const errors = ::testing::internal::GetCapturedStderr();
+  EXPECT_NE(errors.find("Failed writing to file /dev/full"), std::string::npos) << errors;
+}
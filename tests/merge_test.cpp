@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Tests the rapids_logger_merge tool, whose path is given by RAPIDS_LOGGER_MERGE.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct MergeTest : public ::testing::Test {
+  ~MergeTest() override
+  {
+    for (auto const& path : paths) {
+      std::filesystem::remove(path);
+    }
+  }
+
+  std::string write_input(std::string const& contents)
+  {
+    auto const path = prefix + std::to_string(paths.size()) + ".log";
+    std::ofstream{path, std::ios::binary} << contents;
+    paths.push_back(path);
+    return path;
+  }
+
+  /**
+   * @brief Merge the given files and return the merged output.
+   */
+  std::string merge(std::vector<std::string> const& inputs)
+  {
+    auto const output = prefix + "merged.log";
+    paths.push_back(output);
+    std::string command = std::string{RAPIDS_LOGGER_MERGE} + " -o " + output;
+    for (auto const& input : inputs) {
+      command += " " + input;
+    }
+    EXPECT_EQ(std::system(command.c_str()), 0);
+    std::ifstream file{output, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  }
+
+  std::string const prefix{"merge_test_" + std::to_string(::getpid()) + "_"};
+  std::vector<std::string> paths;
+};
+
+/**
+ * @brief Make a record with a fixed-width timestamp, so that records sort by time.
+ */
+std::string record(int time, std::string const& text)
+{
+  char key[32];
+  std::snprintf(key, sizeof(key), "[%09d] ", time);
+  return key + text + "\n";
+}
+
+}  // namespace
+
+TEST_F(MergeTest, Interleaves)
+{
+  // Continuation lines stay with their record, equal keys are taken in command line order, and
+  // a missing final newline is added.
+  auto const a = write_input(record(1, "a") + record(3, "a") + "continued\n" + "[000000005] a");
+  auto const b = write_input(record(2, "b") + record(3, "b") + record(6, "b"));
+  EXPECT_EQ(merge({a, b}),
+            record(1, "a") + record(2, "b") + record(3, "a") + "continued\n" + record(3, "b") +
+              record(5, "a") + record(6, "b"));
+}
+
+TEST_F(MergeTest, LargeInputs)
+{
+  // The inputs are larger than the steps in which consumed input is released from memory.
+  std::string const text(100, 'x');
+  std::string even, odd, expected;
+  for (int time = 0; time < 200000; ++time) {
+    auto const r = record(time, text);
+    (time % 2 == 0 ? even : odd) += r;
+    expected += r;
+  }
+  EXPECT_EQ(merge({write_input(odd), write_input(even)}), expected);
+}
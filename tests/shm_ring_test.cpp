@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "detail/shm_ring.hpp"
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shm_ring = rapids_logger::detail::shm_ring;
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief A ring in private memory, laid out like a shared one.
+ */
+struct private_ring {
+  explicit private_ring(std::size_t capacity)
+    : memory{static_cast<char*>(std::aligned_alloc(shm_ring::data_offset,
+                                                   shm_ring::data_offset + capacity))}
+  {
+    auto* control     = new (memory) shm_ring::header{};
+    control->capacity = capacity;
+  }
+  ~private_ring() { std::free(memory); }
+
+  char* memory;
+};
+
+/**
+ * @brief Make the text of a numbered record, with a size that does not divide the capacity.
+ */
+std::string record_text(int i)
+{
+  auto number = std::to_string(i);
+  return std::string(90, 'x') + std::string(6 - number.size(), '0') + number;
+}
+
+std::string read_text(shm_ring::ring& ring)
+{
+  shm_ring::record_header record{};
+  char const* text{nullptr};
+  if (!ring.peek(record, text)) { return {}; }
+  std::string result{text, record.size};
+  ring.consume(record);
+  return result;
+}
+
+}  // namespace
+
+TEST(ShmRingTest, WrapsWithPadding)
+{
+  private_ring memory{4096};
+  shm_ring::ring ring{memory.memory};
+
+  // Records of this size do not divide the capacity, so writes regularly need padding to wrap.
+  int written{0};
+  int read{0};
+  for (int round = 0; round < 100; ++round) {
+    auto text = record_text(written);
+    while (ring.try_write(0, written, text.data(), text.size())) {
+      text = record_text(++written);
+    }
+    // Leave a varying number of records unread, so the positions drift around the ring.
+    for (int i = 0; i <= round % 7; ++i) {
+      EXPECT_EQ(read_text(ring), record_text(read++));
+    }
+  }
+  while (read < written) {
+    EXPECT_EQ(read_text(ring), record_text(read++));
+  }
+  EXPECT_EQ(read_text(ring), "");
+  EXPECT_GT(written, 100);
+  // Every round ends with a write that does not fit.
+  EXPECT_EQ(ring.control().dropped.load(), 100);
+}
+
+TEST(ShmRingTest, SinkDropsWhenFull)
+{
+  std::string const name{"rapids_logger_test_" + std::to_string(::getpid())};
+  auto const ring_path = "/dev/shm/" + name + "." + std::to_string(::getpid());
+  {
+    // Without a collector draining it, the smallest ring fills up and further records are
+    // dropped rather than blocking the caller.
+    auto sink = std::make_shared<rapids_logger::shm_ring_sink_mt>(name, 4096);
+    rapids_logger::logger logger_{"shm_test", {sink}};
+    logger_.set_pattern("%v");
+    EXPECT_TRUE(std::filesystem::exists(ring_path));
+
+    constexpr int n_messages{1000};
+    for (int i = 0; i < n_messages; ++i) {
+      logger_.info("message %d", i);
+    }
+    auto const metrics = sink->metrics();
+    EXPECT_GT(metrics.drops, 0);
+    EXPECT_LT(metrics.drops, n_messages);
+    // Dropped records are not counted as written.
+    EXPECT_EQ(metrics.messages + metrics.drops, n_messages);
+  }
+  // The collector normally removes the ring once it has drained it.
+  std::filesystem::remove(ring_path);
+}
+
+TEST(ShmRingTest, OneSinkPerName)
+{
+  std::string const name{"rapids_logger_shm_ring_test_" + std::to_string(::getpid())};
+  auto const object_name = shm_ring::object_name(name, ::getpid());
+  {
+    auto first = std::make_shared<rapids_logger::shm_ring_sink_mt>(name);
+    rapids_logger::logger logger_{"first", {first}};
+    logger_.info("first");
+
+    // A second sink would be a second writer of the ring, and would wipe the first's records.
+    EXPECT_THROW(rapids_logger::shm_ring_sink_mt{name}, std::runtime_error);
+    EXPECT_EQ(first->metrics().messages, 1);
+  }
+  // Once the first sink is gone, its uncollected ring is replaced.
+  {
+    rapids_logger::shm_ring_sink_mt second{name};
+  }
+  ::shm_unlink(object_name.c_str());
+}
+
+#ifdef RAPIDS_LOGGER_COLLECTOR
+TEST(ShmRingTest, Collector)
+{
+  std::string const name{"rapids_logger_collector_test_" + std::to_string(::getpid())};
+  auto const output = std::filesystem::temp_directory_path() / (name + ".log");
+  std::filesystem::remove(output);
+
+  // A ring whose name only starts with the collected name is not collected.
+  auto other = std::make_shared<rapids_logger::shm_ring_sink_mt>(name + ".other");
+  rapids_logger::logger other_logger{"other", {other}};
+  other_logger.info("other");
+
+  auto const collector = ::fork();
+  ASSERT_GE(collector, 0);
+  if (collector == 0) {
+    ::execl(RAPIDS_LOGGER_COLLECTOR,
+            RAPIDS_LOGGER_COLLECTOR,
+            "-i",
+            "1",
+            "-o",
+            output.c_str(),
+            name.c_str(),
+            static_cast<char*>(nullptr));
+    std::_Exit(EXIT_FAILURE);
+  }
+
+  // The producers use the smallest ring, so the collector must keep up with rings that wrap.
+  // Records that are dropped because the ring is full are logged again.
+  constexpr int n_producers{3};
+  constexpr int n_messages{2000};
+  std::vector<pid_t> producers;
+  for (int p = 0; p < n_producers; ++p) {
+    auto const pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      {
+        auto sink = std::make_shared<rapids_logger::shm_ring_sink_mt>(name, 4096);
+        rapids_logger::logger logger_{"producer", {sink}};
+        logger_.set_pattern("%v");
+        for (int i = 0; i < n_messages; ++i) {
+          while (true) {
+            auto const drops = sink->metrics().drops;
+            logger_.info("%d %d", p, i);
+            if (sink->metrics().drops == drops) { break; }
+            std::this_thread::sleep_for(100us);
+          }
+        }
+      }
+      std::_Exit(EXIT_SUCCESS);
+    }
+    producers.push_back(pid);
+  }
+  for (auto pid : producers) {
+    int status{};
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+  }
+  // The collector drains the rings once more before it exits. It handles the signal once it has
+  // created the output file.
+  while (!std::filesystem::exists(output)) {
+    std::this_thread::sleep_for(1ms);
+  }
+  ::kill(collector, SIGTERM);
+  int status{};
+  ASSERT_EQ(::waitpid(collector, &status, 0), collector);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+
+  std::ifstream file{output};
+  std::map<int, int> next;
+  std::string line;
+  int n_lines{0};
+  while (std::getline(file, line)) {
+    std::istringstream fields{line};
+    int p{-1}, i{-1};
+    ASSERT_TRUE(fields >> p >> i) << line;
+    EXPECT_EQ(i, next[p]++);
+    ++n_lines;
+  }
+  EXPECT_EQ(n_lines, n_producers * n_messages);
+
+  // The rings of the producers were removed once they were drained.
+  for (auto pid : producers) {
+    EXPECT_FALSE(std::filesystem::exists("/dev/shm" + shm_ring::object_name(name, pid)));
+  }
+  std::filesystem::remove(output);
+  ::shm_unlink(shm_ring::object_name(name + ".other", ::getpid()).c_str());
+}
+#endif
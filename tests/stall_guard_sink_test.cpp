@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// A sink whose writes block while `blocked` is set, like stderr when it is a full pipe.
+std::atomic<bool> blocked{false};
+std::mutex received_mutex;
+std::string received;
+
+void blocking_callback(int, char const* msg)
+{
+  while (blocked.load()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  std::lock_guard lock{received_mutex};
+  received += msg;
+}
+
+std::string received_content()
+{
+  std::lock_guard lock{received_mutex};
+  return received;
+}
+
+void clear_received()
+{
+  std::lock_guard lock{received_mutex};
+  received.clear();
+}
+
+void throwing_callback(int, char const* msg) { throw std::runtime_error{msg}; }
+
+std::mutex transitions_mutex;
+std::vector<bool> transitions;
+
+void record_transition(bool degraded)
+{
+  std::lock_guard lock{transitions_mutex};
+  transitions.push_back(degraded);
+}
+
+/**
+ * @brief Wait until the stall callback has been invoked the given number of times.
+ */
+std::vector<bool> wait_for_transitions(std::size_t count)
+{
+  for (int attempt = 0; attempt < 500; ++attempt) {
+    {
+      std::lock_guard lock{transitions_mutex};
+      if (transitions.size() >= count) { return transitions; }
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  std::lock_guard lock{transitions_mutex};
+  return transitions;
+}
+
+}  // namespace
+
+TEST(StallGuardSinkTest, PassesThrough)
+{
+  std::ostringstream oss;
+  auto guard = std::make_shared<rapids_logger::stall_guard_sink_mt>(
+    std::make_shared<rapids_logger::ostream_sink_mt>(oss));
+  rapids_logger::logger logger_{"stall_guard_test", {guard}};
+  logger_.set_pattern("%v");
+
+  for (int i = 0; i < 3; ++i) {
+    logger_.info("message %d", i);
+  }
+  logger_.flush();
+  EXPECT_EQ(oss.str(), "message 0\nmessage 1\nmessage 2\n");
+  EXPECT_EQ(guard->metrics().drops, 0);
+}
+
+TEST(StallGuardSinkTest, DegradesAndRecovers)
+{
+  auto guard = std::make_shared<rapids_logger::stall_guard_sink_mt>(
+    std::make_shared<rapids_logger::callback_sink_mt>(blocking_callback), 10ms, record_transition);
+  rapids_logger::logger logger_{"stall_guard_test", {guard}};
+  logger_.set_pattern("%v");
+
+  // The writer gets stuck on the first record, and the guard degrades.
+  blocked = true;
+  logger_.info("first");
+  ASSERT_EQ(wait_for_transitions(1), std::vector<bool>{true});
+
+  // Logging threads are not held up, low-severity records are dropped, and errors are kept.
+  constexpr int n_messages{1000};
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("dropped %d", i);
+  }
+  logger_.error("kept");
+  logger_.flush();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+  EXPECT_EQ(guard->metrics().drops, n_messages);
+
+  // Once the sink catches up, the guard recovers and records are written again.
+  blocked = false;
+  EXPECT_EQ(wait_for_transitions(2), (std::vector<bool>{true, false}));
+  logger_.info("after");
+  logger_.flush();
+  EXPECT_EQ(received_content(), "first\nkept\nafter\n");
+}
+
+TEST(StallGuardSinkTest, FlushesDoNotWaitWhileDegraded)
+{
+  clear_received();
+  {
+    std::lock_guard lock{transitions_mutex};
+    transitions.clear();
+  }
+  auto guard = std::make_shared<rapids_logger::stall_guard_sink_mt>(
+    std::make_shared<rapids_logger::callback_sink_mt>(blocking_callback), 100ms, record_transition);
+  rapids_logger::logger logger_{"stall_guard_test", {guard}};
+  logger_.set_pattern("%v");
+  logger_.flush_on(rapids_logger::level_enum::error);
+
+  blocked = true;
+  logger_.info("first");
+  ASSERT_EQ(wait_for_transitions(1), std::vector<bool>{true});
+
+  // Each error triggers a flush, which would wait for a budget if it waited for the writer.
+  constexpr int n_errors{10};
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_errors; ++i) {
+    logger_.error("error %d", i);
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+  blocked = false;
+  EXPECT_EQ(wait_for_transitions(2), (std::vector<bool>{true, false}));
+  logger_.flush();
+  std::string expected{"first\n"};
+  for (int i = 0; i < n_errors; ++i) {
+    expected += "error " + std::to_string(i) + "\n";
+  }
+  EXPECT_EQ(received_content(), expected);
+  clear_received();
+}
+
+TEST(StallGuardSinkTest, DestroyingAStalledGuard)
+{
+  clear_received();
+  blocked = true;
+  auto const start = std::chrono::steady_clock::now();
+  {
+    auto guard = std::make_shared<rapids_logger::stall_guard_sink_mt>(
+      std::make_shared<rapids_logger::callback_sink_mt>(blocking_callback), 10ms);
+    rapids_logger::logger logger_{"stall_guard_test", {guard}};
+    logger_.set_pattern("%v");
+    logger_.info("stuck");
+    logger_.info("queued");
+  }
+  // Destruction does not wait for the stalled sink.
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+  // The write in progress finishes in the background, and the queued record is dropped.
+  blocked = false;
+  for (int attempt = 0; attempt < 500 && received_content().empty(); ++attempt) {
+    std::this_thread::sleep_for(10ms);
+  }
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(received_content(), "stuck\n");
+  clear_received();
+}
+
+TEST(StallGuardSinkTest, ReportsSinkErrors)
+{
+  auto guard = std::make_shared<rapids_logger::stall_guard_sink_mt>(
+    std::make_shared<rapids_logger::callback_sink_mt>(throwing_callback));
+  rapids_logger::logger logger_{"stall_guard_test", {guard}};
+  logger_.set_pattern("%v");
+
+  ::testing::internal::CaptureStderr();
+  logger_.info("boom");
+  logger_.flush();
+  auto const errors = ::testing::internal::GetCapturedStderr();
+  EXPECT_NE(errors.find("Stall guard: boom"), std::string::npos) << errors;
+}
@@ -39,6 +39,12 @@ int main()
   RAPIDS_TEST_LOG_WARN("warn");
   RAPIDS_TEST_LOG_ERROR("error");
   RAPIDS_TEST_LOG_CRITICAL("critical");
+  {
+    // Spans below the active level compile away, and several may share a scope.
+    RAPIDS_TEST_SPAN_TRACE("trace span");
+    RAPIDS_TEST_SPAN_INFO("info span");
+    RAPIDS_TEST_SPAN_CRITICAL("critical span");
+  }
   std::ostringstream expected;
   if (RAPIDS_TEST_LOG_ACTIVE_LEVEL <= RAPIDS_LOGGER_LOG_LEVEL_TRACE) { expected << "trace\n"; }
   if (RAPIDS_TEST_LOG_ACTIVE_LEVEL <= RAPIDS_LOGGER_LOG_LEVEL_DEBUG) { expected << "debug\n"; }
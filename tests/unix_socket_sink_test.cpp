@@ -0,0 +1,331 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <rapids_logger/logger.hpp>
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief A stand-in for a log agent that accepts connections and collects what it receives.
+ *
+ * Reading can be paused to simulate a stalled agent.
+ */
+class socket_server {
+ public:
+  socket_server(std::string path, bool datagram) : path_{std::move(path)}, datagram_{datagram}
+  {
+    ::unlink(path_.c_str());
+    listener_ = ::socket(AF_UNIX, datagram_ ? SOCK_DGRAM : SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+    ::bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    if (!datagram_) { ::listen(listener_, 4); }
+    thread_ = std::thread{[this] { serve(); }};
+  }
+
+  ~socket_server()
+  {
+    stop_ = true;
+    thread_.join();
+    for (auto fd : connections_) {
+      ::close(fd);
+    }
+    ::close(listener_);
+    ::unlink(path_.c_str());
+  }
+
+  void pause() { paused_ = true; }
+  void resume() { paused_ = false; }
+
+  std::string received()
+  {
+    std::lock_guard lock{mutex_};
+    return received_;
+  }
+
+  std::vector<std::string> datagrams()
+  {
+    std::lock_guard lock{mutex_};
+    return datagrams_;
+  }
+
+  /**
+   * @brief Wait until the received text contains the given string.
+   */
+  bool wait_for(std::string const& text, std::chrono::milliseconds timeout = 10s)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (received().find(text) != std::string::npos) { return true; }
+      std::this_thread::sleep_for(1ms);
+    }
+    return false;
+  }
+
+ private:
+  void serve()
+  {
+    std::vector<char> buf(1 << 17);
+    while (!stop_) {
+      std::vector<pollfd> fds{{listener_, POLLIN, 0}};
+      for (auto fd : connections_) {
+        fds.push_back({fd, POLLIN, 0});
+      }
+      if (paused_ || ::poll(fds.data(), fds.size(), 10) <= 0) {
+        std::this_thread::sleep_for(1ms);
+        continue;
+      }
+      if (!datagram_ && (fds[0].revents & POLLIN)) {
+        connections_.push_back(::accept(listener_, nullptr, nullptr));
+      }
+      for (auto const& p : fds) {
+        if (!(p.revents & POLLIN) || (!datagram_ && p.fd == listener_)) { continue; }
+        auto const n = ::recv(p.fd, buf.data(), buf.size(), 0);
+        if (n <= 0) { continue; }
+        std::lock_guard lock{mutex_};
+        received_.append(buf.data(), static_cast<std::size_t>(n));
+        if (datagram_) { datagrams_.emplace_back(buf.data(), static_cast<std::size_t>(n)); }
+      }
+    }
+  }
+
+  std::string path_;
+  bool datagram_;
+  int listener_{-1};
+  std::vector<int> connections_;
+  std::atomic<bool> paused_{false};
+  std::atomic<bool> stop_{false};
+  std::mutex mutex_;
+  std::string received_;
+  std::vector<std::string> datagrams_;
+  std::thread thread_;
+};
+
+std::string socket_path() { return "/tmp/rapids_logger_test_" + std::to_string(::getpid()); }
+
+}  // namespace
+
+TEST(UnixSocketSinkTest, Stream)
+{
+  socket_server server{socket_path(), false};
+  auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(socket_path());
+  rapids_logger::logger logger_{"socket_test", {sink}};
+  logger_.set_pattern("%v");
+
+  constexpr int n_messages{10000};
+  std::string expected;
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("message %d", i);
+    expected += "message " + std::to_string(i) + "\n";
+  }
+  logger_.flush();
+  ASSERT_TRUE(server.wait_for("message " + std::to_string(n_messages - 1) + "\n"));
+  EXPECT_EQ(server.received(), expected);
+  EXPECT_EQ(sink->metrics().drops, 0);
+}
+
+TEST(UnixSocketSinkTest, Datagram)
+{
+  socket_server server{socket_path(), true};
+  auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(socket_path(), true);
+  rapids_logger::logger logger_{"socket_test", {sink}};
+  logger_.set_pattern("%v");
+
+  constexpr int n_messages{10000};
+  std::string expected;
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("message %d", i);
+    expected += "message " + std::to_string(i) + "\n";
+  }
+  logger_.flush();
+  ASSERT_TRUE(server.wait_for("message " + std::to_string(n_messages - 1) + "\n"));
+  EXPECT_EQ(server.received(), expected);
+  // Records are batched, and never split across datagrams.
+  auto const datagrams = server.datagrams();
+  EXPECT_LT(datagrams.size(), n_messages);
+  for (auto const& d : datagrams) {
+    EXPECT_EQ(d.back(), '\n');
+  }
+}
+
+TEST(UnixSocketSinkTest, StalledReceiver)
+{
+  socket_server server{socket_path(), false};
+  auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(socket_path(), false, 1 << 16);
+  rapids_logger::logger logger_{"socket_test", {sink}};
+  logger_.set_pattern("%v");
+  logger_.info("connected");
+  logger_.flush();
+  ASSERT_TRUE(server.wait_for("connected\n"));
+
+  // Once the socket buffers and the pending buffer fill up, records are dropped rather than
+  // blocking the caller.
+  server.pause();
+  constexpr int n_messages{200000};
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("message %d", i);
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+  auto const metrics = sink->metrics();
+  auto const drops   = metrics.drops;
+  EXPECT_GT(drops, 0);
+  EXPECT_LT(drops, n_messages);
+  // Dropped records are not counted as written.
+  EXPECT_EQ(metrics.messages + drops, n_messages + 1);
+
+  // Delivery resumes once the receiver has caught up with the backlog.
+  server.resume();
+  bool recovered{false};
+  for (int attempt = 0; attempt < 100 && !recovered; ++attempt) {
+    logger_.info("recovered");
+    logger_.flush();
+    recovered = server.wait_for("recovered\n", 100ms);
+  }
+  EXPECT_TRUE(recovered);
+}
+
+TEST(UnixSocketSinkTest, DeliversOnDestruction)
+{
+  socket_server server{socket_path(), false};
+  server.pause();
+
+  // More is pending than the socket buffers hold, so destroying the sink has to wait for the
+  // receiver to resume.
+  constexpr int n_messages{50000};
+  std::string expected;
+  std::thread resume;
+  {
+    auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(socket_path());
+    rapids_logger::logger logger_{"socket_test", {sink}};
+    logger_.set_pattern("%v");
+    for (int i = 0; i < n_messages; ++i) {
+      logger_.info("message %d", i);
+      expected += "message " + std::to_string(i) + "\n";
+    }
+    ASSERT_EQ(sink->metrics().drops, 0);
+    logger_.flush();
+    std::this_thread::sleep_for(50ms);
+    resume = std::thread{[&] {
+      std::this_thread::sleep_for(100ms);
+      server.resume();
+    }};
+  }
+  resume.join();
+  ASSERT_TRUE(server.wait_for("message " + std::to_string(n_messages - 1) + "\n"));
+  EXPECT_EQ(server.received(), expected);
+}
+
+TEST(UnixSocketSinkTest, Reconnect)
+{
+  auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(socket_path());
+  rapids_logger::logger logger_{"socket_test", {sink}};
+  logger_.set_pattern("%v");
+
+  // Records logged before the receiver exists are held until it does.
+  logger_.info("early");
+  logger_.flush();
+  std::this_thread::sleep_for(50ms);
+  {
+    socket_server server{socket_path(), false};
+    EXPECT_TRUE(server.wait_for("early\n"));
+  }
+
+  // Records logged while the receiver restarts are delivered to the new connection.
+  logger_.info("late");
+  logger_.flush();
+  std::this_thread::sleep_for(50ms);
+  socket_server server{socket_path(), false};
+  EXPECT_TRUE(server.wait_for("late\n"));
+  EXPECT_EQ(sink->metrics().drops, 0);
+}
+
+TEST(UnixSocketSinkTest, ReconnectAfterPartialSend)
+{
+  auto const path = socket_path();
+  ::unlink(path.c_str());
+  auto const listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  ASSERT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  ASSERT_EQ(::listen(listener, 4), 0);
+
+  auto sink = std::make_shared<rapids_logger::unix_socket_sink_mt>(path, false, 1 << 24);
+  rapids_logger::logger logger_{"socket_test", {sink}};
+  logger_.set_pattern("%v");
+
+  // Records of an odd size fill the socket buffer partway through a record.
+  constexpr int n_messages{4000};
+  std::string const padding(770, 'x');
+  for (int i = 0; i < n_messages; ++i) {
+    logger_.info("%06d %s", i, padding.c_str());
+  }
+  logger_.flush();
+
+  auto const read_available = [](int fd, std::string& text, std::chrono::milliseconds timeout) {
+    std::vector<char> buf(1 << 16);
+    pollfd pfd{fd, POLLIN, 0};
+    while (::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0) {
+      auto const n = ::recv(fd, buf.data(), buf.size(), 0);
+      if (n <= 0) { break; }
+      text.append(buf.data(), static_cast<std::size_t>(n));
+    }
+  };
+
+  // Look at what the first connection managed to send and drop the connection. Reading would
+  // make room for the sender, which could then finish its batch before the reader catches up.
+  auto const first = ::accept(listener, nullptr, nullptr);
+  ASSERT_GE(first, 0);
+  std::this_thread::sleep_for(100ms);
+  std::vector<char> buffered(1 << 24);
+  auto const n_buffered = ::recv(first, buffered.data(), buffered.size(), MSG_PEEK | MSG_DONTWAIT);
+  ASSERT_GT(n_buffered, 0);
+  std::string const first_text{buffered.data(), static_cast<std::size_t>(n_buffered)};
+  ::close(first);
+  ASSERT_FALSE(first_text.empty());
+  ASSERT_NE(first_text.back(), '\n') << "The connection did not end within a record";
+
+  // The next connection resends the torn record in full instead of starting in its middle.
+  auto const second = ::accept(listener, nullptr, nullptr);
+  ASSERT_GE(second, 0);
+  std::string second_text;
+  read_available(second, second_text, 1000ms);
+  ::close(second);
+  ::close(listener);
+  ::unlink(path.c_str());
+
+  std::istringstream lines{second_text};
+  std::string line;
+  int expected{-1};
+  while (std::getline(lines, line)) {
+    ASSERT_EQ(line.size(), 7 + padding.size()) << line.substr(0, 20);
+    auto const index = std::stoi(line.substr(0, 6));
+    if (expected >= 0) { EXPECT_EQ(index, expected); }
+    expected = index + 1;
+  }
+  EXPECT_EQ(expected, n_messages);
+  EXPECT_EQ(second_text.back(), '\n');
+  EXPECT_EQ(sink->metrics().drops, 0);
+}
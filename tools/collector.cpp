@@ -0,0 +1,283 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// rapids_logger_collector drains the shared-memory rings written by shm_ring_sink_mt in any
+// number of processes and merges their records, ordered by timestamp, into a single output.
+
+#include "detail/shm_ring.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shm_ring = rapids_logger::detail::shm_ring;
+
+namespace {
+
+volatile std::sig_atomic_t stop_requested{0};
+
+void request_stop(int) { stop_requested = 1; }
+
+/**
+ * @brief A ring written by one producer process.
+ */
+struct source {
+  std::string object_name;
+  void* mapping;
+  std::size_t size;
+  shm_ring::ring ring;
+  shm_ring::record_header next{};
+  char const* next_text{nullptr};
+  bool has_next{false};
+
+  void advance() { has_next = ring.peek(next, next_text); }
+};
+
+/**
+ * @brief Buffered writes to the output file descriptor.
+ */
+class output {
+ public:
+  explicit output(int fd) : fd_{fd} { buffer_.reserve(capacity); }
+  ~output() { flush(); }
+
+  void write(char const* data, std::size_t size)
+  {
+    if (buffer_.size() + size > capacity) { flush(); }
+    buffer_.insert(buffer_.end(), data, data + size);
+  }
+
+  void flush()
+  {
+    std::size_t written{0};
+    while (written < buffer_.size()) {
+      auto const n = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+      if (n < 0) {
+        if (errno == EINTR) { continue; }
+        std::perror("rapids_logger_collector: write");
+        std::exit(EXIT_FAILURE);
+      }
+      written += static_cast<std::size_t>(n);
+    }
+    buffer_.clear();
+  }
+
+ private:
+  static constexpr std::size_t capacity = 1 << 20;
+  int fd_;
+  std::vector<char> buffer_;
+};
+
+/**
+ * @brief Check whether a file in /dev/shm is the ring of a process using the given name.
+ *
+ * Rings are named `<name>.<pid>`, so the rings of a name such as `foo.bar` are not matched by
+ * `foo`.
+ */
+bool is_ring_of(std::string const& file, std::string const& name)
+{
+  if (file.size() <= name.size() + 1 || file.compare(0, name.size(), name) != 0 ||
+      file[name.size()] != '.') {
+    return false;
+  }
+  return std::all_of(file.begin() + static_cast<std::ptrdiff_t>(name.size()) + 1,
+                     file.end(),
+                     [](char c) { return c >= '0' && c <= '9'; });
+}
+
+class collector {
+ public:
+  collector(std::vector<std::string> names, output& out) : names_{std::move(names)}, out_{out} {}
+
+  ~collector()
+  {
+    for (auto& s : sources_) {
+      ::munmap(s.mapping, s.size);
+    }
+  }
+
+  /**
+   * @brief Map any rings that appeared since the last call.
+   */
+  void discover()
+  {
+    auto* dir = ::opendir("/dev/shm");
+    if (dir == nullptr) { return; }
+    while (auto* entry = ::readdir(dir)) {
+      std::string const file{entry->d_name};
+      for (auto const& name : names_) {
+        if (is_ring_of(file, name)) { open("/" + file); }
+      }
+    }
+    ::closedir(dir);
+  }
+
+  /**
+   * @brief Write every available record, merging the rings by timestamp.
+   */
+  void drain()
+  {
+    for (auto& s : sources_) {
+      s.advance();
+    }
+    while (true) {
+      source* oldest{nullptr};
+      for (auto& s : sources_) {
+        if (s.has_next && (oldest == nullptr || s.next.timestamp_ns < oldest->next.timestamp_ns)) {
+          oldest = &s;
+        }
+      }
+      if (oldest == nullptr) { break; }
+      out_.write(oldest->next_text, oldest->next.size);
+      oldest->ring.consume(oldest->next);
+      oldest->advance();
+    }
+    out_.flush();
+  }
+
+  /**
+   * @brief Unmap and remove rings whose producer has finished or died and that are fully drained.
+   */
+  void reap()
+  {
+    for (auto it = sources_.begin(); it != sources_.end();) {
+      auto& control = it->ring.control();
+      bool const finished =
+        control.closed.load(std::memory_order_acquire) != 0 ||
+        (::kill(static_cast<pid_t>(control.pid), 0) != 0 && errno == ESRCH);
+      if (!finished || control.read_pos.load() != control.write_pos.load()) {
+        ++it;
+        continue;
+      }
+      if (auto const dropped = control.dropped.load(); dropped > 0) {
+        std::cerr << "rapids_logger_collector: " << it->object_name << " dropped " << dropped
+                  << " records" << std::endl;
+      }
+      ::munmap(it->mapping, it->size);
+      ::shm_unlink(it->object_name.c_str());
+      known_.erase(std::find(known_.begin(), known_.end(), it->object_name));
+      it = sources_.erase(it);
+    }
+  }
+
+ private:
+  void open(std::string const& object_name)
+  {
+    if (std::find(known_.begin(), known_.end(), object_name) != known_.end()) { return; }
+    auto const fd = ::shm_open(object_name.c_str(), O_RDWR, 0);
+    if (fd < 0) { return; }
+    struct stat st {};
+    void* mapping{MAP_FAILED};
+    auto const size = (::fstat(fd, &st) == 0) ? static_cast<std::size_t>(st.st_size) : 0;
+    if (size > shm_ring::data_offset) {
+      mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) { return; }
+
+    // A ring that is not initialized yet is picked up again on a later pass.
+    auto* control = static_cast<shm_ring::header*>(mapping);
+    if (std::atomic_ref<std::uint64_t>{control->magic}.load(std::memory_order_acquire) !=
+          shm_ring::magic ||
+        control->version != shm_ring::version ||
+        shm_ring::data_offset + control->capacity != size) {
+      ::munmap(mapping, size);
+      return;
+    }
+    known_.push_back(object_name);
+    sources_.push_back(source{object_name, mapping, size, shm_ring::ring{mapping}});
+  }
+
+  std::vector<std::string> names_;
+  output& out_;
+  std::vector<std::string> known_;
+  std::vector<source> sources_;
+};
+
+void usage()
+{
+  std::cerr << "Usage: rapids_logger_collector [-o FILE] [-i INTERVAL_MS] [--once] NAME...\n"
+               "\n"
+               "Merges the records of every shm_ring_sink_mt created with one of the given names\n"
+               "into FILE (default: stdout), ordered by timestamp. The ring of a process is\n"
+               "removed once the process has exited and its records have been collected.\n"
+               "\n"
+               "  -o FILE         Append the merged output to FILE\n"
+               "  -i INTERVAL_MS  How often to poll the rings (default: 10)\n"
+               "  --once          Drain the rings once and exit\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> names;
+  std::string output_path;
+  int interval_ms{10};
+  bool once{false};
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg{argv[i]};
+    if (arg == "-o" && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (arg == "-i" && i + 1 < argc) {
+      interval_ms = std::atoi(argv[++i]);
+    } else if (arg == "--once") {
+      once = true;
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      return EXIT_SUCCESS;
+    } else {
+      names.push_back(arg);
+    }
+  }
+  if (names.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  // Install the handlers first, so that a stop requested once the output exists drains the rings.
+  std::signal(SIGINT, request_stop);
+  std::signal(SIGTERM, request_stop);
+
+  int fd{STDOUT_FILENO};
+  if (!output_path.empty()) {
+    fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+      std::perror(("rapids_logger_collector: " + output_path).c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  output out{fd};
+  collector c{names, out};
+  while (true) {
+    // Read the request before the pass, so that the last pass starts after the signal arrived
+    // and sees every record written before it was sent.
+    bool const last_pass = once || stop_requested != 0;
+    c.discover();
+    c.drain();
+    c.reap();
+    if (last_pass) { break; }
+    std::this_thread::sleep_for(std::chrono::milliseconds{interval_ms});
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// rapids_logger_merge merges the log files written by the processes of a job into a single
+// output, ordered by the timestamp that starts each record.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Consumed input is released from the mapping in steps of this size, so that resident memory
+// stays bounded however large the inputs are.
+constexpr std::size_t release_step = std::size_t{1} << 22;
+
+/**
+ * @brief A memory-mapped input file and the position of its next record.
+ *
+ * A record starts with a line beginning with '[', as in the default pattern
+ * `[%Y-%m-%d %H:%M:%S.%e] ...`, and includes any following lines that do not (e.g. the rest of a
+ * multi-line message). Records are ordered by the bracketed text, which for fixed-width
+ * timestamps orders them by time.
+ */
+class input {
+ public:
+  input(std::string path, std::size_t index) : path_{std::move(path)}, index_{index} {}
+
+  ~input()
+  {
+    if (data_ != nullptr) { ::munmap(const_cast<char*>(data_), size_); }
+  }
+
+  input(input const&)            = delete;
+  input& operator=(input const&) = delete;
+
+  /**
+   * @brief Map the file.
+   *
+   * @return false if the file could not be mapped
+   */
+  bool open()
+  {
+    auto const fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { return false; }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      auto* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        ::close(fd);
+        return false;
+      }
+      ::madvise(mapping, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<char const*>(mapping);
+    }
+    ::close(fd);
+    return true;
+  }
+
+  std::string const& path() const noexcept { return path_; }
+  std::size_t index() const noexcept { return index_; }
+  std::string_view key() const noexcept { return key_; }
+  std::string_view record() const noexcept { return {data_ + begin_, end_ - begin_}; }
+
+  /**
+   * @brief Move to the next record.
+   *
+   * @return false if there are no more records
+   */
+  bool advance()
+  {
+    begin_ = end_;
+    release();
+    if (begin_ >= size_) { return false; }
+    end_ = line_end(begin_);
+    while (end_ < size_ && data_[end_] != '[') {
+      end_ = line_end(end_);
+    }
+    key_ = {};
+    if (auto const* start = data_ + begin_; *start == '[') {
+      auto const* close = static_cast<char const*>(std::memchr(start, ']', end_ - begin_));
+      if (close != nullptr) { key_ = {start, static_cast<std::size_t>(close - start) + 1}; }
+    }
+    return true;
+  }
+
+ private:
+  std::size_t line_end(std::size_t pos) const
+  {
+    auto const* newline = static_cast<char const*>(std::memchr(data_ + pos, '\n', size_ - pos));
+    return (newline == nullptr) ? size_ : static_cast<std::size_t>(newline - data_) + 1;
+  }
+
+  void release()
+  {
+    if (begin_ - released_ < release_step) { return; }
+    auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const end  = begin_ / page * page;
+    ::madvise(const_cast<char*>(data_) + released_, end - released_, MADV_DONTNEED);
+    released_ = end;
+  }
+
+  std::string path_;
+  std::size_t index_;
+  char const* data_{nullptr};
+  std::size_t size_{0};
+  std::size_t begin_{0};     ///< Start of the current record
+  std::size_t end_{0};       ///< End of the current record
+  std::size_t released_{0};  ///< Bytes at the start of the mapping already released
+  std::string_view key_;
+};
+
+/**
+ * @brief Buffered writes to the output file descriptor.
+ */
+class output {
+ public:
+  explicit output(int fd) : fd_{fd} { buffer_.reserve(capacity); }
+  ~output() { flush(); }
+
+  void write(std::string_view data)
+  {
+    if (buffer_.size() + data.size() > capacity) { flush(); }
+    if (data.size() > capacity) {
+      write_fd(data.data(), data.size());
+      return;
+    }
+    buffer_.insert(buffer_.end(), data.begin(), data.end());
+  }
+
+  void flush()
+  {
+    write_fd(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+
+ private:
+  void write_fd(char const* data, std::size_t size)
+  {
+    while (size > 0) {
+      auto const n = ::write(fd_, data, size);
+      if (n < 0) {
+        if (errno == EINTR) { continue; }
+        std::perror("rapids_logger_merge: write");
+        std::exit(EXIT_FAILURE);
+      }
+      data += n;
+      size -= static_cast<std::size_t>(n);
+    }
+  }
+
+  static constexpr std::size_t capacity = 1 << 20;
+  int fd_;
+  std::vector<char> buffer_;
+};
+
+/**
+ * @brief Orders inputs so that the one with the earliest record is on top of the heap.
+ *
+ * Records with equal keys are taken from the inputs in command line order.
+ */
+struct later_record {
+  bool operator()(input const* a, input const* b) const
+  {
+    if (a->key() != b->key()) { return a->key() > b->key(); }
+    return a->index() > b->index();
+  }
+};
+
+void usage()
+{
+  std::cerr << "Usage: rapids_logger_merge [-o FILE] INPUT...\n"
+               "\n"
+               "Merges log files into FILE (default: stdout), ordered by the bracketed timestamp\n"
+               "that starts each record, as in the default pattern. Lines that do not start with\n"
+               "'[' are kept with the record before them. Each input must already be in order.\n"
+               "\n"
+               "  -o FILE  Write the merged output to FILE\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> paths;
+  std::string output_path;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg{argv[i]};
+    if (arg == "-o" && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      return EXIT_SUCCESS;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::unique_ptr<input>> inputs;
+  for (auto const& path : paths) {
+    inputs.push_back(std::make_unique<input>(path, inputs.size()));
+    if (!inputs.back()->open()) {
+      std::perror(("rapids_logger_merge: " + path).c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  int fd{STDOUT_FILENO};
+  if (!output_path.empty()) {
+    fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      std::perror(("rapids_logger_merge: " + output_path).c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  output out{fd};
+  std::priority_queue<input*, std::vector<input*>, later_record> heap;
+  for (auto& in : inputs) {
+    if (in->advance()) { heap.push(in.get()); }
+  }
+  while (!heap.empty()) {
+    auto* in = heap.top();
+    heap.pop();
+    auto const record = in->record();
+    out.write(record);
+    // The last line of a file may be missing its newline.
+    if (record.back() != '\n') { out.write("\n"); }
+    if (in->advance()) { heap.push(in); }
+  }
+  return EXIT_SUCCESS;
+}